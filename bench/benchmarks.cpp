@@ -0,0 +1,589 @@
+#include "../include/base_types.h"
+#include "../include/object_ref.h"
+#include "../include/shared_class.h"
+#include "../include/worker_output.h"
+#include "../lib/shared_library.h"
+#include "../src/host_implementation.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace WeakSymbolExample;
+
+namespace {
+
+    // Sink that drops whatever the workers write
+    class NullSink : public WorkerOutputSink {
+    public:
+        void write(const char*, std::size_t) override {}
+    };
+
+    NullSink s_nullSink;
+
+} // namespace
+
+// Factory costs: creating in the DLL vs. creating in the host
+// Arg 0 = AllocationPolicy::Heap, Arg 1 = AllocationPolicy::Pooled
+
+static void BM_CreateDLLSharedWorker(benchmark::State& state) {
+    const auto policy = static_cast<AllocationPolicy>(state.range(0));
+    for (auto _ : state) {
+        auto worker = createDLLSharedWorker(42, policy);
+        benchmark::DoNotOptimize(worker.get());
+    }
+}
+BENCHMARK(BM_CreateDLLSharedWorker)->Arg(0)->Arg(1);
+
+static void BM_CreateHostSharedWorker(benchmark::State& state) {
+    for (auto _ : state) {
+        auto worker = createHostSharedWorker(42);
+        benchmark::DoNotOptimize(worker.get());
+    }
+}
+BENCHMARK(BM_CreateHostSharedWorker);
+
+static void BM_CreateDestroyDLLObjectC(benchmark::State& state) {
+    for (auto _ : state) {
+        IBaseObject* obj = create_dll_object_c(42);
+        benchmark::DoNotOptimize(obj);
+        destroy_dll_object_c(obj);
+    }
+}
+BENCHMARK(BM_CreateDestroyDLLObjectC);
+
+static void BM_CreateDestroyDLLObjectPooledC(benchmark::State& state) {
+    for (auto _ : state) {
+        IBaseObject* obj = create_dll_object_pooled_c(42);
+        benchmark::DoNotOptimize(obj);
+        destroy_dll_object_c(obj);
+    }
+}
+BENCHMARK(BM_CreateDestroyDLLObjectPooledC);
+
+// Worker sets built one call per object vs. one call per batch
+// Both draw from the per-thread pool, so only the batching differs
+
+static void BM_CreateDestroySetPerObjectC(benchmark::State& state) {
+    std::vector<IBaseObject*> objects(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        for (size_t i = 0; i < objects.size(); ++i) {
+            objects[i] = create_dll_object_pooled_c(static_cast<int>(i));
+        }
+        for (IBaseObject* obj : objects) {
+            destroy_dll_object_c(obj);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CreateDestroySetPerObjectC)->Arg(1024)->Arg(16384);
+
+static void BM_CreateDestroySetBatchedC(benchmark::State& state) {
+    std::vector<int> values(static_cast<size_t>(state.range(0)));
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<int>(i);
+    }
+    std::vector<IBaseObject*> objects(values.size());
+    for (auto _ : state) {
+        create_dll_objects_c(values.data(), values.size(), objects.data());
+        destroy_dll_objects_c(objects.data(), objects.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CreateDestroySetBatchedC)->Arg(1024)->Arg(16384);
+
+// Virtual dispatch costs on objects created on either side of the boundary
+// Arg 0 = object created in the host, Arg 1 = object created in the DLL
+
+static std::unique_ptr<AbstractWorker> makeBenchWorker(const benchmark::State& state) {
+    return state.range(0) == 0 ? createHostSharedWorker(42) : createDLLSharedWorker(42);
+}
+
+static void BM_VirtualGetValue(benchmark::State& state) {
+    auto worker = makeBenchWorker(state);
+    IBaseObject* obj = worker.get();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(obj);
+        benchmark::DoNotOptimize(obj->getValue());
+    }
+}
+BENCHMARK(BM_VirtualGetValue)->Arg(0)->Arg(1);
+
+static void BM_VirtualIsReady(benchmark::State& state) {
+    auto worker = makeBenchWorker(state);
+    AbstractWorker* obj = worker.get();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(obj);
+        benchmark::DoNotOptimize(obj->isReady());
+    }
+}
+BENCHMARK(BM_VirtualIsReady)->Arg(0)->Arg(1);
+
+// Create a worker through a factory and query it right away
+// With WEAK_SYMBOL_STATIC_LTO the factory can be inlined, the concrete type
+// becomes visible and the virtual calls can be devirtualized; compare the
+// shared and static builds with compare_link_modes.sh
+static void BM_CreateAndQueryWorker(benchmark::State& state) {
+    for (auto _ : state) {
+        auto worker = makeBenchWorker(state);
+        benchmark::DoNotOptimize(worker->getValue());
+        benchmark::DoNotOptimize(worker->isReady());
+    }
+}
+BENCHMARK(BM_CreateAndQueryWorker)->Arg(0)->Arg(1);
+
+// Sharing a DLL worker: shared_ptr (separate control block) vs. ObjectRef
+// (intrusive count); each iteration creates, shares once and drops the worker
+
+static void BM_ShareWorkerSharedPtr(benchmark::State& state) {
+    for (auto _ : state) {
+        std::shared_ptr<AbstractWorker> worker(createDLLSharedWorker(42, AllocationPolicy::Pooled));
+        std::shared_ptr<AbstractWorker> copy = worker;
+        benchmark::DoNotOptimize(copy.get());
+    }
+}
+BENCHMARK(BM_ShareWorkerSharedPtr);
+
+static void BM_ShareWorkerObjectRef(benchmark::State& state) {
+    for (auto _ : state) {
+        ObjectRef<AbstractWorker> worker(createDLLSharedWorker(42, AllocationPolicy::Pooled));
+        ObjectRef<AbstractWorker> copy = worker;
+        benchmark::DoNotOptimize(copy.get());
+    }
+}
+BENCHMARK(BM_ShareWorkerObjectRef);
+
+// A request's worker set: individually owned unique_ptrs vs. one arena
+// Arg = workers per request; a third of them own a std::string payload
+
+static void BM_RequestWorkersUniquePtr(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    std::vector<WorkerPtr> workers;
+    workers.reserve(static_cast<std::size_t>(count));
+    for (auto _ : state) {
+        for (int i = 0; i < count; ++i) {
+            if (i % 3 == 2) {
+                workers.push_back(createDLLTemplatedWorkerString("payload"));
+            } else {
+                workers.push_back(createDLLSharedWorker(i, AllocationPolicy::Pooled));
+            }
+        }
+        benchmark::DoNotOptimize(workers.data());
+        workers.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RequestWorkersUniquePtr)->Arg(300);
+
+static void BM_RequestWorkersArena(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    const std::string payload = "payload";
+    WorkerArena arena;
+    std::vector<AbstractWorker*> workers;
+    workers.reserve(static_cast<std::size_t>(count));
+    for (auto _ : state) {
+        for (int i = 0; i < count; ++i) {
+            if (i % 3 == 2) {
+                workers.push_back(createDLLTemplatedWorker(payload, arena));
+            } else {
+                workers.push_back(createDLLSharedWorker(i, arena));
+            }
+        }
+        benchmark::DoNotOptimize(workers.data());
+        workers.clear();
+        arena.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RequestWorkersArena)->Arg(300);
+
+// Handing workers between threads under contention: every thread pushes its
+// worker and pops one back, through WorkerQueue vs. a mutex-guarded deque
+
+static WorkerQueue s_contendedQueue(1024);
+
+static void BM_WorkerQueuePushPop(benchmark::State& state) {
+    WorkerPtr worker = createDLLSharedWorker(state.thread_index(), AllocationPolicy::Pooled);
+    IBaseObject* obj = worker.release();
+    for (auto _ : state) {
+        while (!s_contendedQueue.tryPush(obj)) {}
+        while (!(obj = s_contendedQueue.tryPop())) {}
+    }
+    delete obj;
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_WorkerQueuePushPop)->ThreadRange(1, 4)->UseRealTime();
+
+static std::mutex s_contendedMutex;
+static std::deque<IBaseObject*> s_contendedDeque;
+
+static void BM_MutexQueuePushPop(benchmark::State& state) {
+    WorkerPtr worker = createDLLSharedWorker(state.thread_index(), AllocationPolicy::Pooled);
+    IBaseObject* obj = worker.release();
+    for (auto _ : state) {
+        {
+            std::lock_guard<std::mutex> lock(s_contendedMutex);
+            s_contendedDeque.push_back(obj);
+        }
+        std::lock_guard<std::mutex> lock(s_contendedMutex);
+        obj = s_contendedDeque.front();
+        s_contendedDeque.pop_front();
+    }
+    delete obj;
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MutexQueuePushPop)->ThreadRange(1, 4)->UseRealTime();
+
+// Full dynamic_cast walk used by testDynamicCast vs. the shared cast cache
+
+static void BM_DynamicCastWalk(benchmark::State& state) {
+    auto worker = makeBenchWorker(state);
+    IBaseObject* obj = worker.get();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(obj);
+        benchmark::DoNotOptimize(dynamic_cast<AbstractWorker*>(obj));
+        benchmark::DoNotOptimize(dynamic_cast<SharedWorker*>(obj));
+        benchmark::DoNotOptimize(dynamic_cast<TemplatedWorker<int>*>(obj));
+        benchmark::DoNotOptimize(dynamic_cast<TemplatedWorker<std::string>*>(obj));
+    }
+}
+BENCHMARK(BM_DynamicCastWalk)->Arg(0)->Arg(1);
+
+static void BM_CachedCastWalk(benchmark::State& state) {
+    auto worker = makeBenchWorker(state);
+    IBaseObject* obj = worker.get();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(obj);
+        benchmark::DoNotOptimize(cachedCast<AbstractWorker>(obj));
+        benchmark::DoNotOptimize(cachedCast<SharedWorker>(obj));
+        benchmark::DoNotOptimize(cachedCast<TemplatedWorker<int>>(obj));
+        benchmark::DoNotOptimize(cachedCast<TemplatedWorker<std::string>>(obj));
+    }
+}
+BENCHMARK(BM_CachedCastWalk)->Arg(0)->Arg(1);
+
+// Type identification: RTTI string building vs. registry IDs
+
+static void BM_GetTypeInfoString(benchmark::State& state) {
+    auto worker = makeBenchWorker(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(getTypeInfo(worker.get()));
+    }
+}
+BENCHMARK(BM_GetTypeInfoString)->Arg(0)->Arg(1);
+
+static void BM_TypeIdLookup(benchmark::State& state) {
+    auto worker = makeBenchWorker(state);
+    IBaseObject* obj = worker.get();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(obj);
+        benchmark::DoNotOptimize(typeId(obj));
+    }
+}
+BENCHMARK(BM_TypeIdLookup)->Arg(0)->Arg(1);
+
+// Descriptions: allocating getDescription vs. caller-supplied buffer
+
+static void BM_GetDescription(benchmark::State& state) {
+    auto worker = makeBenchWorker(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(worker->getDescription());
+    }
+}
+BENCHMARK(BM_GetDescription)->Arg(0)->Arg(1);
+
+static void BM_DescribeTo(benchmark::State& state) {
+    auto worker = makeBenchWorker(state);
+    char buffer[128];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(worker->describeTo(buffer, sizeof(buffer)));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_DescribeTo)->Arg(0)->Arg(1);
+
+// Weak symbol call that is interposed between the host and the DLL
+static void BM_WeakFunctionCall(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Internal::getSharedFunctionResult());
+    }
+}
+BENCHMARK(BM_WeakFunctionCall);
+
+// Worker output: per-line sink writes vs. per-thread batches vs. dropped
+// Arg = WorkerOutputMode (0 = Immediate, 1 = Buffered, 2 = Discard)
+
+static void BM_PerformAction(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        setWorkerOutputMode(static_cast<WorkerOutputMode>(state.range(0)));
+    }
+
+    auto worker = createHostSharedWorker(42);
+    for (auto _ : state) {
+        worker->performAction();
+    }
+    flushWorkerOutput();
+
+    if (state.thread_index() == 0) {
+        setWorkerOutputMode(WorkerOutputMode::Discard);
+    }
+}
+BENCHMARK(BM_PerformAction)->Arg(0)->Arg(1)->Arg(2)->ThreadRange(1, 4);
+
+// Running a worker batch: sequential loop vs. the work-stealing executor
+// Workers write buffered output to the null sink so doWork does real formatting
+
+static std::vector<WorkerPtr> makeWorkerBatch(std::size_t count) {
+    std::vector<WorkerPtr> workers;
+    for (std::size_t i = 0; i < count; ++i) {
+        const int value = static_cast<int>(i) + 1;
+        workers.push_back(i % 2 ? createHostSharedWorker(value) : createDLLSharedWorker(value));
+    }
+    return workers;
+}
+
+static void BM_RunWorkersSequential(benchmark::State& state) {
+    auto workers = makeWorkerBatch(static_cast<std::size_t>(state.range(0)));
+    setWorkerOutputMode(WorkerOutputMode::Buffered);
+    for (auto _ : state) {
+        for (const WorkerPtr& worker : workers) {
+            if (worker->isReady()) worker->doWork();
+        }
+    }
+    setWorkerOutputMode(WorkerOutputMode::Discard);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RunWorkersSequential)->Arg(1024)->Arg(65536);
+
+static void BM_RunWorkersExecutor(benchmark::State& state) {
+    auto workers = makeWorkerBatch(static_cast<std::size_t>(state.range(0)));
+    WorkerExecutor executor;
+    setWorkerOutputMode(WorkerOutputMode::Buffered);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(executor.run(workers));
+    }
+    setWorkerOutputMode(WorkerOutputMode::Discard);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RunWorkersExecutor)->Arg(1024)->Arg(65536)->UseRealTime();
+
+// Reading values from a homogeneous batch: one virtual call per object vs.
+// getValues, which resolves the concrete type once and calls it directly
+
+static std::vector<IBaseObject*> batchPointers(const std::vector<WorkerPtr>& workers) {
+    std::vector<IBaseObject*> objects;
+    for (const WorkerPtr& worker : workers) objects.push_back(worker.get());
+    return objects;
+}
+
+static void BM_GetValuesVirtual(benchmark::State& state) {
+    auto workers = makeWorkerBatch(static_cast<std::size_t>(state.range(0)));
+    const auto objects = batchPointers(workers);
+    std::vector<int> values(objects.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < objects.size(); ++i) {
+            values[i] = objects[i]->getValue();
+        }
+        benchmark::DoNotOptimize(values.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GetValuesVirtual)->Arg(4096);
+
+static void BM_GetValuesBatch(benchmark::State& state) {
+    auto workers = makeWorkerBatch(static_cast<std::size_t>(state.range(0)));
+    const auto objects = batchPointers(workers);
+    std::vector<int> values(objects.size());
+    for (auto _ : state) {
+        getValues(objects.data(), objects.size(), values.data());
+        benchmark::DoNotOptimize(values.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GetValuesBatch)->Arg(4096);
+
+// Mixed host/DLL batch of four worker types in shuffled order: virtual calls
+// in array order vs. the batch calls (getValues stays a single pass)
+
+static std::vector<WorkerPtr> makeMixedWorkerBatch(std::size_t count) {
+    std::vector<WorkerPtr> workers;
+    workers.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const int value = static_cast<int>(i);
+        switch (i % 4) {
+            case 0: workers.push_back(createHostSharedWorker(value)); break;
+            case 1: workers.push_back(createDLLSharedWorker(value)); break;
+            case 2: workers.push_back(createDLLTemplatedWorker(static_cast<double>(value))); break;
+            default: workers.push_back(createHostTemplatedWorkerInt(value)); break;
+        }
+    }
+    std::shuffle(workers.begin(), workers.end(), std::mt19937(42));
+    return workers;
+}
+
+static void BM_MixedGetValuesVirtual(benchmark::State& state) {
+    auto workers = makeMixedWorkerBatch(static_cast<std::size_t>(state.range(0)));
+    const auto objects = batchPointers(workers);
+    std::vector<int> values(objects.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < objects.size(); ++i) {
+            values[i] = objects[i]->getValue();
+        }
+        benchmark::DoNotOptimize(values.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MixedGetValuesVirtual)->Arg(4096);
+
+static void BM_MixedGetValuesBatch(benchmark::State& state) {
+    auto workers = makeMixedWorkerBatch(static_cast<std::size_t>(state.range(0)));
+    const auto objects = batchPointers(workers);
+    std::vector<int> values(objects.size());
+    for (auto _ : state) {
+        getValues(objects.data(), objects.size(), values.data());
+        benchmark::DoNotOptimize(values.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MixedGetValuesBatch)->Arg(4096);
+
+static void BM_MixedIsReadyVirtual(benchmark::State& state) {
+    auto workers = makeMixedWorkerBatch(static_cast<std::size_t>(state.range(0)));
+    std::unique_ptr<bool[]> flags(new bool[workers.size()]);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < workers.size(); ++i) {
+            flags[i] = workers[i]->isReady();
+        }
+        benchmark::DoNotOptimize(flags.get());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MixedIsReadyVirtual)->Arg(4096);
+
+static void BM_MixedIsReadyGrouped(benchmark::State& state) {
+    auto workers = makeMixedWorkerBatch(static_cast<std::size_t>(state.range(0)));
+    const auto objects = batchPointers(workers);
+    std::unique_ptr<bool[]> flags(new bool[objects.size()]);
+    for (auto _ : state) {
+        getReadyFlags(objects.data(), objects.size(), flags.get());
+        benchmark::DoNotOptimize(flags.get());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MixedIsReadyGrouped)->Arg(4096);
+
+static void BM_MixedPerformActionVirtual(benchmark::State& state) {
+    auto workers = makeMixedWorkerBatch(static_cast<std::size_t>(state.range(0)));
+    setWorkerOutputMode(WorkerOutputMode::Discard);
+    for (auto _ : state) {
+        for (const WorkerPtr& worker : workers) {
+            worker->performAction();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MixedPerformActionVirtual)->Arg(4096);
+
+static void BM_MixedPerformActionGrouped(benchmark::State& state) {
+    auto workers = makeMixedWorkerBatch(static_cast<std::size_t>(state.range(0)));
+    const auto objects = batchPointers(workers);
+    setWorkerOutputMode(WorkerOutputMode::Discard);
+    for (auto _ : state) {
+        performActions(objects.data(), objects.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MixedPerformActionGrouped)->Arg(4096);
+
+// Counting ready workers: virtual isReady over heap objects vs. the SoA store
+
+static void BM_CountReadyHeapWorkers(benchmark::State& state) {
+    auto workers = makeWorkerBatch(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::size_t ready = 0;
+        for (const WorkerPtr& worker : workers) {
+            ready += worker->isReady();
+        }
+        benchmark::DoNotOptimize(ready);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CountReadyHeapWorkers)->Arg(1 << 20);
+
+static void BM_CountReadyStore(benchmark::State& state) {
+    SharedWorkerStore store;
+    store.reserve(static_cast<std::size_t>(state.range(0)));
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        store.add(static_cast<int>(i % 7) - 3, i % 2 ? "HOST" : "DLL");
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(store.countReady());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CountReadyStore)->Arg(1 << 20);
+
+#ifdef WEAK_SYMBOL_ENABLE_COROUTINES
+// Interleaving coroutine workers on one thread: each worker yields to the
+// event loop between steps; items are worker steps (suspend + resume)
+
+namespace {
+
+    class YieldingWorker : public SharedWorker {
+    public:
+        YieldingWorker(int value, int steps) : SharedWorker(value, "HOST"), m_steps(steps) {}
+        
+        WorkerTask doWorkAsync() override {
+            for (int step = 0; step < m_steps; ++step) {
+                benchmark::DoNotOptimize(getValue());
+                co_await EventLoop::yield();
+            }
+        }
+        
+    private:
+        int m_steps;
+    };
+
+} // namespace
+
+static void BM_EventLoopInterleave(benchmark::State& state) {
+    constexpr int kSteps = 16;
+    std::vector<std::unique_ptr<YieldingWorker>> workers;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        workers.push_back(std::make_unique<YieldingWorker>(static_cast<int>(i), kSteps));
+    }
+    EventLoop loop;
+    for (auto _ : state) {
+        for (auto& worker : workers) loop.spawn(*worker);
+        benchmark::DoNotOptimize(loop.run());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * kSteps);
+}
+BENCHMARK(BM_EventLoopInterleave)->Arg(1000)->Arg(10000);
+#endif
+
+// Benchmark entry point
+int main(int argc, char** argv) {
+    // Factory logging would otherwise be part of every measurement
+    // Output enabled by individual benchmarks lands in the null sink
+    setWorkerOutputSink(&s_nullSink);
+    setWorkerOutputMode(WorkerOutputMode::Discard);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
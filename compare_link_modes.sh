@@ -0,0 +1,66 @@
+#!/bin/bash
+
+set -e  # Exit on error
+
+# Builds the project once per binding/interposition mode, plus the static LTO
+# variant, and compares loader startup cost and per-call factory latency.
+# Each build also runs the gtest suite, which must keep passing: RTTI has to
+# unify in every mode.
+#
+# Extra CMake arguments can be passed through CMAKE_ARGS, e.g.
+#   CMAKE_ARGS="-DCMAKE_CXX_FLAGS=-O2" ./compare_link_modes.sh
+
+echo "=== Link Mode Comparison ==="
+echo "Platform: $(uname -s)"
+
+if [ "$(uname -s)" = "Darwin" ]; then
+    echo "These modes are ELF linker options; nothing to compare on macOS."
+    exit 0
+fi
+
+MODES=(
+    "default|"
+    "now|-DWEAK_SYMBOL_BINDING=now"
+    "lazy|-DWEAK_SYMBOL_BINDING=lazy"
+    "bsymbolic-functions|-DWEAK_SYMBOL_BSYMBOLIC_FUNCTIONS=ON"
+    "dynamic-list|-DWEAK_SYMBOL_DYNAMIC_LIST=ON"
+    "no-semantic-interposition|-DWEAK_SYMBOL_NO_SEMANTIC_INTERPOSITION=ON"
+    "now+dynamic-list+no-semantic-interposition|-DWEAK_SYMBOL_BINDING=now -DWEAK_SYMBOL_DYNAMIC_LIST=ON -DWEAK_SYMBOL_NO_SEMANTIC_INTERPOSITION=ON"
+    "static-lto|-DWEAK_SYMBOL_STATIC_LTO=ON"
+)
+
+BENCH_FILTER="BM_CreateDLLSharedWorker/0|BM_CreateDestroyDLLObjectC|BM_CreateAndQueryWorker|BM_VirtualGetValue/1|BM_WeakFunctionCall"
+
+for entry in "${MODES[@]}"; do
+    name="${entry%%|*}"
+    flags="${entry#*|}"
+    dir="build-link-${name//+/-}"
+
+    echo ""
+    echo "========================================"
+    echo "Mode: ${name}"
+    echo "========================================"
+
+    # shellcheck disable=SC2086
+    cmake -S . -B "${dir}" ${flags} ${CMAKE_ARGS} > /dev/null
+    cmake --build "${dir}" -j > /dev/null
+
+    # RTTI unification must hold in every mode
+    if ! "./${dir}/WeakSymbolHost" --gtest_brief=1 > "${dir}/tests.log" 2>&1; then
+        echo "❌ Test suite failed in mode ${name} (see ${dir}/tests.log)"
+        exit 1
+    fi
+    echo "✅ Test suite passed"
+
+    # Loader startup cost, plus a fresh eager/lazy load of the library
+    "./${dir}/WeakSymbolHost" --profile-startup \
+        | grep -E "total startup time|time needed for relocation|number of relocations|total symbol bindings|RTLD_(NOW|LAZY)" \
+        || true
+
+    # Per-call latency of the factories and interposed functions
+    "./${dir}/WeakSymbolBench" --benchmark_filter="${BENCH_FILTER}" 2>/dev/null \
+        | grep -E "^BM_" || true
+done
+
+echo ""
+echo "🎉 Link mode comparison completed"
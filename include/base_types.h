@@ -1,6 +1,12 @@
 #pragma once
 
+#include "format_buffer.h"
+#include "worker_task.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <new>
 #include <string>
 #include <typeinfo>
 
@@ -13,6 +19,77 @@
 
 namespace WeakSymbolExample {
 
+    // Allocation strategy used to place IBaseObject instances in memory
+    // Every heap-allocated IBaseObject carries a small header recording how to
+    // release its block, so deleting from either side of the boundary always
+    // returns the memory to the allocator (and library) that produced it
+    struct ObjectAllocator {
+        void* (*allocate)(std::size_t blockSize);
+        void (*release)(void* block, std::size_t blockSize);
+    };
+
+    namespace Detail {
+
+        // Header placed in front of every heap-allocated IBaseObject
+        struct alignas(alignof(std::max_align_t)) AllocationHeader {
+            void (*release)(void* block, std::size_t blockSize);
+            std::size_t blockSize;
+        };
+
+        inline void* heapAllocate(std::size_t blockSize) {
+            return ::operator new(blockSize);
+        }
+
+        inline void heapRelease(void* block, std::size_t) {
+            ::operator delete(block);
+        }
+
+        inline void* allocateObject(std::size_t size, const ObjectAllocator& allocator) {
+            const std::size_t blockSize = sizeof(AllocationHeader) + size;
+            void* block = allocator.allocate(blockSize);
+            AllocationHeader* header = ::new (block) AllocationHeader{allocator.release, blockSize};
+            return header + 1;
+        }
+
+        inline void releaseObject(void* ptr) noexcept {
+            if (!ptr) return;
+            AllocationHeader* header = static_cast<AllocationHeader*>(ptr) - 1;
+            header->release(header, header->blockSize);
+        }
+
+    } // namespace Detail
+
+    // Compact type identifiers agreed between host and DLL
+    // The registry lives in the DLL and maps mangled type names to small
+    // integers; the well-known worker types are registered when it loads,
+    // so their IDs are compile-time constants that hot code can switch on
+    using TypeId = std::uint32_t;
+
+    enum : TypeId {
+        kInvalidTypeId = 0,
+        kSharedWorkerTypeId,
+        kTemplatedWorkerIntTypeId,
+        kTemplatedWorkerStringTypeId,
+        kFirstDynamicTypeId
+    };
+
+    // Return the ID for a mangled type name, assigning a new one if needed
+    API_EXPORT TypeId registerTypeId(const char* mangledName);
+    
+    // Mangled name registered for an ID, or nullptr if the ID is unknown
+    API_EXPORT const char* typeIdName(TypeId id);
+    
+    // ID for a dynamic type through a lock-free cache keyed by type_info
+    // address; only a type's first lookup takes the registry lock
+    API_EXPORT TypeId typeIdOf(const std::type_info& type);
+
+    // ID of type T, resolved through the registry once per binary
+    template<typename T>
+    TypeId staticTypeId() {
+        static const TypeId id = registerTypeId(typeid(T).name());
+        return id;
+    }
+
     // Base interface that all our objects will inherit from
     class API_EXPORT IBaseObject {
     public:
@@ -20,21 +97,125 @@ namespace WeakSymbolExample {
         
         // Virtual methods that derived classes can override
         virtual std::string getTypeName() const = 0;
-        virtual std::string getDescription() const = 0;
         virtual int getValue() const = 0;
         
+        // Format the description into a caller-owned buffer without allocating
+        // Returns the full description length (snprintf semantics): output is
+        // truncated to fit and null-terminated when capacity > 0
+        // Subclasses must override describeTo, getDescription or both, since
+        // each default is written in terms of the other; this one copies from
+        // getDescription() and so allocates
+        virtual std::size_t describeTo(char* buffer, std::size_t capacity) const {
+            return BufferWriter(buffer, capacity).append(getDescription()).length();
+        }
+        
+        // Allocating wrapper around describeTo
+        virtual std::string getDescription() const {
+            char buffer[128];
+            const std::size_t length = describeTo(buffer, sizeof(buffer));
+            if (length < sizeof(buffer)) {
+                return std::string(buffer, length);
+            }
+            std::string description(length + 1, '\0');
+            describeTo(&description[0], description.size());
+            description.resize(length);
+            return description;
+        }
+        
         // Method to demonstrate virtual function calls across boundary
         virtual void performAction() = 0;
+        
+        // Registry ID of the dynamic type; override to skip the cache probe
+        virtual TypeId getTypeId() const {
+            return typeIdOf(typeid(*this));
+        }
+        
+        // Class-specific allocation so every delete goes back through the header
+        static void* operator new(std::size_t size) {
+            static const ObjectAllocator heapAllocator = {
+                &Detail::heapAllocate, &Detail::heapRelease
+            };
+            return Detail::allocateObject(size, heapAllocator);
+        }
+        
+        // Allocate with a specific allocator: new (allocator) SharedWorker(...)
+        static void* operator new(std::size_t size, const ObjectAllocator& allocator) {
+            return Detail::allocateObject(size, allocator);
+        }
+        
+        static void operator delete(void* ptr) noexcept {
+            Detail::releaseObject(ptr);
+        }
+        
+        // Called only if a constructor throws during allocator placement
+        static void operator delete(void* ptr, const ObjectAllocator&) noexcept {
+            Detail::releaseObject(ptr);
+        }
+        
+        // Intrusive reference count used by ObjectRef (include/object_ref.h)
+        // A new object starts at 1, the reference held by its creator; the
+        // release() that drops the count to 0 deletes it, returning the block
+        // through its allocation header. Owners that delete directly
+        // (unique_ptr, destroy_dll_object_c) ignore the count
+        void retain() const noexcept {
+            m_refCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        
+        void release() const noexcept {
+            if (m_refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete this;
+            }
+        }
+        
+        std::uint32_t refCount() const noexcept {
+            return m_refCount.load(std::memory_order_relaxed);
+        }
+        
+    protected:
+        IBaseObject() noexcept : m_refCount(1) {}
+        
+        // A copy is a new object with only its creator's reference; assignment
+        // keeps the target's count
+        IBaseObject(const IBaseObject&) noexcept : m_refCount(1) {}
+        
+        IBaseObject& operator=(const IBaseObject&) noexcept {
+            return *this;
+        }
+        
+    private:
+        mutable std::atomic<std::uint32_t> m_refCount;
     };
 
+    namespace Detail {
+
+        // Object whose AbstractWorker::describeTo is forwarding to getDescription
+        inline const IBaseObject*& describingObject() {
+            static thread_local const IBaseObject* object = nullptr;
+            return object;
+        }
+
+    } // namespace Detail
+
     // An intermediate base class to demonstrate inheritance hierarchy
     class API_EXPORT AbstractWorker : public IBaseObject {
     public:
         virtual ~AbstractWorker() {}
         
-        // Common implementation
-        std::string getDescription() const override {
-            return "AbstractWorker base implementation";
+        // Common implementation for workers that override neither describeTo
+        // nor getDescription; workers that only override getDescription still
+        // get their own text, and the guard stops the two defaults recursing
+        std::size_t describeTo(char* buffer, std::size_t capacity) const override {
+            const IBaseObject*& describing = Detail::describingObject();
+            if (describing == this) {
+                return BufferWriter(buffer, capacity)
+                    .append("AbstractWorker base implementation")
+                    .length();
+            }
+            const IBaseObject* const previous = describing;
+            describing = this;
+            const std::size_t length = IBaseObject::describeTo(buffer, capacity);
+            describing = previous;
+            return length;
         }
         
         // Pure virtual method that must be implemented
@@ -44,8 +225,23 @@ namespace WeakSymbolExample {
         virtual bool isReady() const {
             return true;
         }
+        
+#ifdef WEAK_SYMBOL_ENABLE_COROUTINES
+        // Asynchronous doWork for workers that wait: suspend (for example
+        // co_await EventLoop::yield()) instead of blocking the thread
+        // The default runs doWork() to completion
+        virtual WorkerTask doWorkAsync() {
+            doWork();
+            co_return;
+        }
+#endif
     };
 
+    // Type ID query without locking or allocation once the type is known
+    inline TypeId typeId(const IBaseObject* obj) {
+        return obj ? obj->getTypeId() : kInvalidTypeId;
+    }
+
     // Forward declaration of our shared class
     class SharedWorker;
     
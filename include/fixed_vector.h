@@ -0,0 +1,61 @@
+#pragma once
+
+#include "format_buffer.h"
+#include <cstddef>
+#include <ostream>
+
+namespace WeakSymbolExample {
+
+    // Fixed-size numeric vector carried inline by TemplatedWorker payloads
+    // An aggregate, so Float4{1, 2, 3, 4} works and copies are plain memcpy
+    template<typename T, std::size_t N>
+    struct FixedVector {
+        T values[N];
+
+        static constexpr std::size_t size() {
+            return N;
+        }
+
+        T& operator[](std::size_t index) {
+            return values[index];
+        }
+
+        const T& operator[](std::size_t index) const {
+            return values[index];
+        }
+
+        friend bool operator==(const FixedVector& a, const FixedVector& b) {
+            for (std::size_t i = 0; i < N; ++i) {
+                if (!(a.values[i] == b.values[i])) return false;
+            }
+            return true;
+        }
+
+        friend bool operator!=(const FixedVector& a, const FixedVector& b) {
+            return !(a == b);
+        }
+    };
+
+    using Float4 = FixedVector<float, 4>;
+    using Double4 = FixedVector<double, 4>;
+
+    // Formats as "(x, y, z, w)" without allocating
+    template<typename T, std::size_t N>
+    void appendValue(BufferWriter& out, const FixedVector<T, N>& value) {
+        out.append("(");
+        for (std::size_t i = 0; i < N; ++i) {
+            if (i > 0) out.append(", ");
+            appendValue(out, value[i]);
+        }
+        out.append(")");
+    }
+
+    template<typename T, std::size_t N>
+    std::ostream& operator<<(std::ostream& os, const FixedVector<T, N>& value) {
+        char buffer[32 * N + 8];
+        BufferWriter out(buffer, sizeof(buffer));
+        appendValue(out, value);
+        return os << buffer;
+    }
+
+} // namespace WeakSymbolExample
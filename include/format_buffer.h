@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+namespace WeakSymbolExample {
+
+    // Formats text into a caller-owned buffer without heap allocation
+    // Follows snprintf semantics: output is truncated to fit (always
+    // null-terminated when capacity > 0) and length() reports the full size
+    class BufferWriter {
+    public:
+        BufferWriter(char* buffer, std::size_t capacity)
+            : m_buffer(buffer), m_capacity(capacity), m_length(0) {
+            if (m_capacity > 0) m_buffer[0] = '\0';
+        }
+
+        BufferWriter& append(const char* text, std::size_t count) {
+            if (m_length + 1 < m_capacity) {
+                const std::size_t room = m_capacity - 1 - m_length;
+                const std::size_t copied = count < room ? count : room;
+                std::memcpy(m_buffer + m_length, text, copied);
+                m_buffer[m_length + copied] = '\0';
+            }
+            m_length += count;
+            return *this;
+        }
+
+        BufferWriter& append(const char* text) {
+            return append(text, std::strlen(text));
+        }
+
+        BufferWriter& append(const std::string& text) {
+            return append(text.data(), text.size());
+        }
+
+        // Length of the complete output, excluding the terminator
+        std::size_t length() const {
+            return m_length;
+        }
+
+    private:
+        char* m_buffer;
+        std::size_t m_capacity;
+        std::size_t m_length;
+    };
+
+    // Value formatting matching what std::ostream << produces
+    template<typename T>
+    void appendValue(BufferWriter& out, const T& value) {
+        // Fallback for types without an allocation-free overload
+        std::ostringstream ss;
+        ss << value;
+        out.append(ss.str());
+    }
+
+    inline void appendValue(BufferWriter& out, const std::string& value) {
+        out.append(value);
+    }
+
+    inline void appendValue(BufferWriter& out, const char* value) {
+        out.append(value);
+    }
+
+    inline void appendValue(BufferWriter& out, int value) {
+        char digits[16];
+        out.append(digits, static_cast<std::size_t>(std::snprintf(digits, sizeof(digits), "%d", value)));
+    }
+
+    inline void appendValue(BufferWriter& out, long value) {
+        char digits[32];
+        out.append(digits, static_cast<std::size_t>(std::snprintf(digits, sizeof(digits), "%ld", value)));
+    }
+
+    inline void appendValue(BufferWriter& out, long long value) {
+        char digits[32];
+        out.append(digits, static_cast<std::size_t>(std::snprintf(digits, sizeof(digits), "%lld", value)));
+    }
+
+    inline void appendValue(BufferWriter& out, double value) {
+        char digits[32];
+        out.append(digits, static_cast<std::size_t>(std::snprintf(digits, sizeof(digits), "%g", value)));
+    }
+
+    inline void appendValue(BufferWriter& out, float value) {
+        appendValue(out, static_cast<double>(value));
+    }
+
+} // namespace WeakSymbolExample
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "base_types.h"
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace WeakSymbolExample {
+
+    // Shared ownership of an IBaseObject through its intrusive reference count
+    // The count lives in the object, so sharing needs no control block, and
+    // the last release deletes through the allocation header: the block goes
+    // back to whichever library (and allocator) created it. Only heap objects
+    // from new or the create* factories may be held, never stack objects
+    template<typename T>
+    class ObjectRef {
+    public:
+        ObjectRef() noexcept : m_ptr(nullptr) {}
+        
+        ObjectRef(std::nullptr_t) noexcept : m_ptr(nullptr) {}
+        
+        // Takes over a factory result and its creator reference
+        template<typename U>
+        ObjectRef(std::unique_ptr<U>&& owner) noexcept : m_ptr(owner.release()) {}
+        
+        // Raw pointers are taken one of two explicit ways; there is no T*
+        // constructor, since a fresh object already holds its creator's
+        // reference and adding one would leak it
+        
+        // Takes over the reference ptr's owner holds, such as the creator
+        // reference of an object from new or a C factory
+        static ObjectRef adopt(T* ptr) noexcept {
+            return ObjectRef(ptr, false);
+        }
+        
+        // Adds a reference to ptr; whoever holds its existing reference
+        // (another ObjectRef, a unique_ptr, a C caller) keeps it and must
+        // release it separately
+        static ObjectRef share(T* ptr) noexcept {
+            return ObjectRef(ptr, true);
+        }
+        
+        ObjectRef(const ObjectRef& other) noexcept : ObjectRef(other.m_ptr, true) {}
+        
+        template<typename U>
+        ObjectRef(const ObjectRef<U>& other) noexcept : ObjectRef(other.get(), true) {}
+        
+        ObjectRef(ObjectRef&& other) noexcept : m_ptr(other.m_ptr) {
+            other.m_ptr = nullptr;
+        }
+        
+        template<typename U>
+        ObjectRef(ObjectRef<U>&& other) noexcept : m_ptr(other.detach()) {}
+        
+        ~ObjectRef() {
+            if (m_ptr) m_ptr->release();
+        }
+        
+        ObjectRef& operator=(ObjectRef other) noexcept {
+            swap(other);
+            return *this;
+        }
+        
+        void reset() noexcept {
+            ObjectRef().swap(*this);
+        }
+        
+        void swap(ObjectRef& other) noexcept {
+            std::swap(m_ptr, other.m_ptr);
+        }
+        
+        // Gives up the reference without releasing it (see adopt)
+        T* detach() noexcept {
+            T* ptr = m_ptr;
+            m_ptr = nullptr;
+            return ptr;
+        }
+        
+        T* get() const noexcept {
+            return m_ptr;
+        }
+        
+        T& operator*() const noexcept {
+            return *m_ptr;
+        }
+        
+        T* operator->() const noexcept {
+            return m_ptr;
+        }
+        
+        explicit operator bool() const noexcept {
+            return m_ptr != nullptr;
+        }
+        
+        // Number of references to the object, 0 when empty
+        std::uint32_t useCount() const noexcept {
+            return m_ptr ? m_ptr->refCount() : 0;
+        }
+        
+    private:
+        ObjectRef(T* ptr, bool addReference) noexcept : m_ptr(ptr) {
+            if (m_ptr && addReference) m_ptr->retain();
+        }
+        
+        T* m_ptr;
+    };
+
+    template<typename T, typename U>
+    bool operator==(const ObjectRef<T>& a, const ObjectRef<U>& b) noexcept {
+        return a.get() == b.get();
+    }
+
+    template<typename T, typename U>
+    bool operator!=(const ObjectRef<T>& a, const ObjectRef<U>& b) noexcept {
+        return a.get() != b.get();
+    }
+
+    // Allocate a T and share it: makeObjectRef<SharedWorker>(42, "HOST")
+    template<typename T, typename... Args>
+    ObjectRef<T> makeObjectRef(Args&&... args) {
+        return ObjectRef<T>::adopt(new T(std::forward<Args>(args)...));
+    }
+
+    // dynamic_cast counterpart; empty if obj is not a T
+    template<typename T, typename U>
+    ObjectRef<T> dynamicRefCast(const ObjectRef<U>& obj) {
+        return ObjectRef<T>::share(dynamic_cast<T*>(obj.get()));
+    }
+
+} // namespace WeakSymbolExample
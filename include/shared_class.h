@@ -1,8 +1,14 @@
 #pragma once
 
 #include "base_types.h"
+#include "fixed_vector.h"
+#include "source_name.h"
+#include "worker_output.h"
+#include <climits>
+#include <cstdint>
 #include <iostream>
 #include <sstream>
+#include <type_traits>
 
 namespace WeakSymbolExample {
 
@@ -11,13 +17,17 @@ namespace WeakSymbolExample {
     class API_EXPORT SharedWorker : public AbstractWorker {
     private:
         int m_value;
-        std::string m_source;
+        SourceName m_source;
         
     public:
         // Constructor that takes a value and source identifier
         SharedWorker(int value, const std::string& source) 
             : m_value(value), m_source(source) {}
         
+        // Constructor for callers that interned the source name up front
+        SharedWorker(int value, SourceName source)
+            : m_value(value), m_source(source) {}
+        
         virtual ~SharedWorker() {}
         
         // Override virtual methods from base classes
@@ -25,25 +35,34 @@ namespace WeakSymbolExample {
             return "SharedWorker";
         }
         
-        std::string getDescription() const override {
-            std::stringstream ss;
-            ss << "SharedWorker created from " << m_source 
-               << " with value " << m_value;
-            return ss.str();
+        std::size_t describeTo(char* buffer, std::size_t capacity) const override {
+            BufferWriter out(buffer, capacity);
+            out.append("SharedWorker created from ").append(m_source.str()).append(" with value ");
+            appendValue(out, m_value);
+            return out.length();
         }
         
         int getValue() const override {
             return m_value;
         }
         
+        TypeId getTypeId() const override {
+            return kSharedWorkerTypeId;
+        }
+        
         void performAction() override {
-            std::cout << "SharedWorker::performAction() called from " 
-                      << m_source << " with value " << m_value << std::endl;
+            if (!workerOutputEnabled()) return;
+            WorkerLine line;
+            line << "SharedWorker::performAction() called from " 
+                 << m_source.str() << " with value " << m_value;
+            line.emit();
         }
         
         void doWork() override {
-            std::cout << "SharedWorker::doWork() - Processing work from " 
-                      << m_source << std::endl;
+            if (!workerOutputEnabled()) return;
+            WorkerLine line;
+            line << "SharedWorker::doWork() - Processing work from " << m_source.str();
+            line.emit();
         }
         
         bool isReady() const override {
@@ -56,6 +75,11 @@ namespace WeakSymbolExample {
         }
         
         const std::string& getSource() const {
+            return m_source.str();
+        }
+        
+        // Interned handle; equal sources compare equal by pointer
+        SourceName getSourceName() const {
             return m_source;
         }
         
@@ -65,47 +89,114 @@ namespace WeakSymbolExample {
         }
     };
 
+    namespace Detail {
+
+        // Saturating conversions of arithmetic payloads to int; NaN maps to 0
+        template<typename T>
+        int saturateToInt(T value, std::true_type /* floating point */) {
+            if (value != value) return 0;
+            if (value >= static_cast<T>(INT_MAX)) return INT_MAX;
+            if (value <= static_cast<T>(INT_MIN)) return INT_MIN;
+            return static_cast<int>(value);
+        }
+
+        template<typename T>
+        int saturateToInt(T value, std::false_type /* integral */) {
+            if (std::is_signed<T>::value) {
+                const std::intmax_t wide = static_cast<std::intmax_t>(value);
+                return wide > INT_MAX ? INT_MAX : wide < INT_MIN ? INT_MIN : static_cast<int>(wide);
+            }
+            const std::uintmax_t wide = static_cast<std::uintmax_t>(value);
+            return wide > static_cast<std::uintmax_t>(INT_MAX) ? INT_MAX : static_cast<int>(wide);
+        }
+
+        // getValue() of a payload: the saturated value for arithmetic types,
+        // 0 for everything else (strings, vectors)
+        template<typename T>
+        int payloadValue(const T& data, std::true_type /* arithmetic */) {
+            return saturateToInt(data, std::is_floating_point<T>());
+        }
+
+        template<typename T>
+        int payloadValue(const T&, std::false_type /* not arithmetic */) {
+            return 0;
+        }
+
+    } // namespace Detail
+
     // Template specialization to demonstrate weak symbol behavior with templates
     template<typename T>
     class TemplatedWorker : public AbstractWorker {
     private:
         T m_data;
-        std::string m_source;
+        SourceName m_source;
         
     public:
         TemplatedWorker(const T& data, const std::string& source)
             : m_data(data), m_source(source) {}
         
+        TemplatedWorker(const T& data, SourceName source)
+            : m_data(data), m_source(source) {}
+        
         virtual ~TemplatedWorker() {}
         
         std::string getTypeName() const override {
             return "TemplatedWorker<" + std::string(typeid(T).name()) + ">";
         }
         
-        std::string getDescription() const override {
-            std::stringstream ss;
-            ss << "TemplatedWorker from " << m_source << " with data: " << m_data;
-            return ss.str();
+        std::size_t describeTo(char* buffer, std::size_t capacity) const override {
+            BufferWriter out(buffer, capacity);
+            out.append("TemplatedWorker from ").append(m_source.str()).append(" with data: ");
+            appendValue(out, m_data);
+            return out.length();
         }
         
+        // Arithmetic payloads saturated to int; 0 for other payload types
         int getValue() const override {
-            return static_cast<int>(reinterpret_cast<intptr_t>(&m_data));
+            return Detail::payloadValue(m_data, std::is_arithmetic<T>());
+        }
+        
+        TypeId getTypeId() const override {
+            return staticTypeId<TemplatedWorker<T>>();
         }
         
         void performAction() override {
-            std::cout << "TemplatedWorker::performAction() from " << m_source << std::endl;
+            if (!workerOutputEnabled()) return;
+            WorkerLine line;
+            line << "TemplatedWorker::performAction() from " << m_source.str();
+            line.emit();
         }
         
         void doWork() override {
-            std::cout << "TemplatedWorker::doWork() with data: " << m_data << std::endl;
+            if (!workerOutputEnabled()) return;
+            WorkerLine line;
+            line << "TemplatedWorker::doWork() with data: " << m_data;
+            line.emit();
         }
         
         const T& getData() const { return m_data; }
+        
+        const std::string& getSource() const { return m_source.str(); }
+        SourceName getSourceName() const { return m_source; }
     };
 
-    // Explicit instantiation declarations for common types
+    // Payload types whose TemplatedWorker instantiations, generic factory and
+    // C entry points are compiled into the DLL
+    // X(Type, Name): Type must not contain commas; Name is used in logging
+    #define WEAK_SYMBOL_TEMPLATED_WORKER_TYPES(X) \
+        X(int, "int") \
+        X(std::string, "string") \
+        X(std::int64_t, "int64_t") \
+        X(double, "double") \
+        X(float, "float") \
+        X(Float4, "Float4") \
+        X(Double4, "Double4")
+
+    // Explicit instantiation declarations for the listed types
     // These will have weak symbol definitions in both host and DLL
-    extern template class TemplatedWorker<int>;
-    extern template class TemplatedWorker<std::string>;
+    #define WEAK_SYMBOL_EXTERN_TEMPLATED_WORKER(Type, Name) \
+        extern template class TemplatedWorker<Type>;
+    WEAK_SYMBOL_TEMPLATED_WORKER_TYPES(WEAK_SYMBOL_EXTERN_TEMPLATED_WORKER)
+    #undef WEAK_SYMBOL_EXTERN_TEMPLATED_WORKER
 
 } // namespace WeakSymbolExample 
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "base_types.h"
+#include <string>
+
+namespace WeakSymbolExample {
+
+    // Intern a source name in the table owned by the DLL
+    // Equal names always return the same pointer; entries are never freed
+    API_EXPORT const std::string* internSourceName(const std::string& name);
+
+    // Pointer-sized handle to an interned source name ("DLL", "HOST", ...)
+    // Handles for equal names compare equal by pointer
+    class SourceName {
+    public:
+        explicit SourceName(const std::string& name)
+            : m_name(internSourceName(name)) {}
+
+        explicit SourceName(const char* name)
+            : m_name(internSourceName(name)) {}
+
+        const std::string& str() const {
+            return *m_name;
+        }
+
+        bool operator==(const SourceName& other) const {
+            return m_name == other.m_name;
+        }
+
+        bool operator!=(const SourceName& other) const {
+            return m_name != other.m_name;
+        }
+
+    private:
+        const std::string* m_name;
+    };
+
+} // namespace WeakSymbolExample
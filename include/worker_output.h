@@ -0,0 +1,69 @@
+#pragma once
+
+#include "base_types.h"
+#include "format_buffer.h"
+#include <cstddef>
+
+namespace WeakSymbolExample {
+
+    // How worker output (performAction, doWork, factory logging) is delivered
+    enum class WorkerOutputMode {
+        Immediate,  // Each line goes to the sink as it is written (default)
+        Buffered,   // Lines collect in a per-thread buffer, written in batches
+        Discard     // Output is dropped before it is even formatted
+    };
+
+    // Destination for worker output; write() receives one or more whole lines
+    // Calls are serialized by the library, so sinks need no locking of their own
+    class API_EXPORT WorkerOutputSink {
+    public:
+        virtual ~WorkerOutputSink() {}
+        virtual void write(const char* data, std::size_t length) = 0;
+    };
+
+    // Output state is owned by the DLL and shared by host and DLL workers
+    API_EXPORT void setWorkerOutputMode(WorkerOutputMode mode);
+    API_EXPORT WorkerOutputMode workerOutputMode();
+
+    // Install a sink (not owned); nullptr restores the default std::cout sink
+    API_EXPORT void setWorkerOutputSink(WorkerOutputSink* sink);
+
+    // Emit one line (a newline is appended) according to the current mode
+    API_EXPORT void writeWorkerLine(const char* text, std::size_t length);
+
+    // Write out the calling thread's buffered lines
+    // Buffers are also flushed when full and when their thread exits
+    API_EXPORT void flushWorkerOutput();
+
+    inline bool workerOutputEnabled() {
+        return workerOutputMode() != WorkerOutputMode::Discard;
+    }
+
+    // A line formatted on the stack and handed to the output sink
+    class WorkerLine {
+    public:
+        WorkerLine() : m_writer(m_buffer, sizeof(m_buffer)) {}
+
+        WorkerLine& operator<<(const char* text) {
+            m_writer.append(text);
+            return *this;
+        }
+
+        template<typename T>
+        WorkerLine& operator<<(const T& value) {
+            appendValue(m_writer, value);
+            return *this;
+        }
+
+        // Overlong lines are truncated to the buffer size
+        void emit() {
+            const std::size_t length = m_writer.length();
+            writeWorkerLine(m_buffer, length < sizeof(m_buffer) ? length : sizeof(m_buffer) - 1);
+        }
+
+    private:
+        char m_buffer[256];
+        BufferWriter m_writer;
+    };
+
+} // namespace WeakSymbolExample
@@ -0,0 +1,120 @@
+#pragma once
+
+// Coroutine task type for AbstractWorker::doWorkAsync()
+// Only available with WEAK_SYMBOL_ENABLE_COROUTINES (C++20)
+#ifdef WEAK_SYMBOL_ENABLE_COROUTINES
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+namespace WeakSymbolExample {
+
+    // Lazily started coroutine with no result
+    // Nothing runs until the task is awaited (co_await task) or handed to an
+    // EventLoop. Exceptions are stored and rethrown to the awaiting coroutine
+    class [[nodiscard]] WorkerTask {
+    public:
+        struct promise_type;
+        using Handle = std::coroutine_handle<promise_type>;
+        
+        // Called when a task that nobody awaits finishes (used by EventLoop)
+        using CompletionHook = void (*)(void* context, Handle task);
+        
+        struct promise_type {
+            std::coroutine_handle<> continuation;
+            std::exception_ptr exception;
+            CompletionHook onComplete = nullptr;
+            void* completionContext = nullptr;
+            
+            // Finishing resumes the awaiting coroutine directly (symmetric
+            // transfer), so chains of awaited tasks do not grow the stack
+            struct FinalAwaiter {
+                bool await_ready() const noexcept { return false; }
+                
+                std::coroutine_handle<> await_suspend(Handle task) const noexcept {
+                    promise_type& promise = task.promise();
+                    if (promise.continuation) return promise.continuation;
+                    if (promise.onComplete) promise.onComplete(promise.completionContext, task);
+                    return std::noop_coroutine();
+                }
+                
+                void await_resume() const noexcept {}
+            };
+            
+            WorkerTask get_return_object() noexcept {
+                return WorkerTask(Handle::from_promise(*this));
+            }
+            
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            FinalAwaiter final_suspend() const noexcept { return {}; }
+            void return_void() const noexcept {}
+            
+            void unhandled_exception() noexcept {
+                exception = std::current_exception();
+            }
+        };
+        
+        struct Awaiter {
+            Handle task;
+            
+            bool await_ready() const noexcept {
+                return !task || task.done();
+            }
+            
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept {
+                task.promise().continuation = awaiting;
+                return task;
+            }
+            
+            void await_resume() const {
+                if (task && task.promise().exception) {
+                    std::rethrow_exception(task.promise().exception);
+                }
+            }
+        };
+        
+        WorkerTask() noexcept : m_handle(nullptr) {}
+        
+        WorkerTask(WorkerTask&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+        
+        WorkerTask& operator=(WorkerTask&& other) noexcept {
+            if (this != &other) {
+                destroy();
+                m_handle = std::exchange(other.m_handle, nullptr);
+            }
+            return *this;
+        }
+        
+        ~WorkerTask() {
+            destroy();
+        }
+        
+        // Start (or continue) the task; resumes the awaiter when it finishes
+        Awaiter operator co_await() const noexcept {
+            return Awaiter{m_handle};
+        }
+        
+        bool done() const noexcept {
+            return !m_handle || m_handle.done();
+        }
+        
+        // Give up ownership of the coroutine frame
+        Handle release() noexcept {
+            return std::exchange(m_handle, nullptr);
+        }
+        
+    private:
+        explicit WorkerTask(Handle handle) noexcept : m_handle(handle) {}
+        
+        void destroy() noexcept {
+            if (m_handle) m_handle.destroy();
+            m_handle = nullptr;
+        }
+        
+        Handle m_handle;
+    };
+
+} // namespace WeakSymbolExample
+
+#endif // WEAK_SYMBOL_ENABLE_COROUTINES
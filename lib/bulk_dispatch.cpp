@@ -0,0 +1,299 @@
+#include "bulk_dispatch.h"
+#include "cast_cache.h"
+#include "../include/shared_class.h"
+#include <cstdint>
+#include <typeinfo>
+
+namespace WeakSymbolExample {
+
+    namespace {
+
+        // Itanium C++ ABI: the vptr is the first word of a polymorphic object,
+        // and objects of the same dynamic type share it once vtables unify
+        const void* vptrOf(const IBaseObject* obj) {
+            return *reinterpret_cast<const void* const*>(obj);
+        }
+
+        // Batches are grouped one chunk at a time in fixed-size scratch space,
+        // so no call allocates. A chunk holds up to kMaxGroups type groups;
+        // objects of further types share one overflow group
+        constexpr std::size_t kChunkSize = 256;
+        constexpr std::size_t kMaxGroups = 8;
+
+        // Objects of one dynamic type (or the overflow group, with no sample);
+        // members are indices[begin, end) into the caller's array, or
+        // positions [begin, end) when indices is null
+        struct TypeGroup {
+            const void* vptr;
+            IBaseObject* sample;
+            std::size_t begin;
+            std::size_t end;
+        };
+
+        class GroupedChunk {
+        public:
+            GroupedChunk(IBaseObject* const* objects, std::size_t begin, std::size_t end)
+                : m_groupCount(0), m_contiguous(false) {
+                // One type and no gaps: members are the chunk itself
+                if (objects[begin]) {
+                    const void* vptr = vptrOf(objects[begin]);
+                    std::size_t same = begin + 1;
+                    while (same < end && objects[same] && vptrOf(objects[same]) == vptr) ++same;
+                    if (same == end) {
+                        m_groups[0] = TypeGroup{vptr, objects[begin], begin, end};
+                        m_groupCount = 1;
+                        m_contiguous = true;
+                        return;
+                    }
+                }
+                group(objects, begin, end);
+            }
+            
+            std::size_t groupCount() const {
+                return m_groupCount;
+            }
+            
+            const TypeGroup& group(std::size_t g) const {
+                return m_groups[g];
+            }
+            
+            const std::size_t* indices() const {
+                return m_contiguous ? nullptr : m_indices;
+            }
+            
+        private:
+            void group(IBaseObject* const* objects, std::size_t begin, std::size_t end) {
+                // The overflow group only exists once all kMaxGroups are taken,
+                // so its slot is always m_groups[kMaxGroups]
+                constexpr std::uint8_t kNoGroup = UINT8_MAX;
+                constexpr std::uint8_t kOverflow = kMaxGroups;
+                std::uint8_t groupOf[kChunkSize];
+                std::size_t sizes[kMaxGroups + 1] = {};
+                
+                // Usually a handful of types: remember the last match and
+                // scan the group list otherwise
+                std::uint8_t last = kNoGroup;
+                for (std::size_t i = begin; i < end; ++i) {
+                    if (!objects[i]) {
+                        groupOf[i - begin] = kNoGroup;
+                        continue;
+                    }
+                    const void* vptr = vptrOf(objects[i]);
+                    if (last == kNoGroup || m_groups[last].vptr != vptr) {
+                        const std::size_t typed = m_groupCount < kMaxGroups ? m_groupCount : kMaxGroups;
+                        last = 0;
+                        while (last < typed && m_groups[last].vptr != vptr) ++last;
+                        if (last == kOverflow) {
+                            m_groups[kOverflow] = TypeGroup{nullptr, nullptr, 0, 0};
+                            m_groupCount = kMaxGroups + 1;
+                        } else if (last == m_groupCount) {
+                            m_groups[m_groupCount++] = TypeGroup{vptr, objects[i], 0, 0};
+                        }
+                    }
+                    groupOf[i - begin] = last;
+                    ++sizes[last];
+                }
+                
+                std::size_t offset = 0;
+                for (std::size_t g = 0; g < m_groupCount; ++g) {
+                    m_groups[g].begin = m_groups[g].end = offset;
+                    offset += sizes[g];
+                }
+                for (std::size_t i = begin; i < end; ++i) {
+                    if (groupOf[i - begin] != kNoGroup) {
+                        m_indices[m_groups[groupOf[i - begin]].end++] = i;
+                    }
+                }
+            }
+            
+            TypeGroup m_groups[kMaxGroups + 1];
+            std::size_t m_indices[kChunkSize];
+            std::size_t m_groupCount;
+            bool m_contiguous;
+        };
+
+        // Calls run(group, indices) for every group, chunk by chunk
+        template<typename F>
+        void forEachGroup(IBaseObject* const* objects, std::size_t count, F run) {
+            for (std::size_t begin = 0; begin < count; begin += kChunkSize) {
+                const std::size_t end = count - begin < kChunkSize ? count : begin + kChunkSize;
+                const GroupedChunk chunk(objects, begin, end);
+                for (std::size_t g = 0; g < chunk.groupCount(); ++g) {
+                    run(chunk.group(g), chunk.indices());
+                }
+            }
+        }
+
+        // Calls f(i) for each member position; a contiguous group gets its own
+        // loop so the common homogeneous case stays a plain indexed loop
+        template<typename F>
+        void forEachMember(const std::size_t* indices, std::size_t begin, std::size_t end, F f) {
+            if (indices) {
+                for (std::size_t k = begin; k < end; ++k) f(indices[k]);
+            } else {
+                for (std::size_t i = begin; i < end; ++i) f(i);
+            }
+        }
+
+        // getValue has trivial implementations, so grouping costs more than
+        // the mispredicted calls it removes; getValues keeps a single pass
+        using GetValuesFn = void (*)(IBaseObject* const*, std::size_t, int*);
+
+        void getValuesVirtual(IBaseObject* const* objects, std::size_t count, int* out) {
+            for (std::size_t i = 0; i < count; ++i) {
+                out[i] = objects[i] ? objects[i]->getValue() : 0;
+            }
+        }
+
+        // Qualified call: statically bound to T's implementation
+        template<typename T>
+        void getValuesAs(IBaseObject* const* objects, std::size_t count, int* out) {
+            for (std::size_t i = 0; i < count; ++i) {
+                out[i] = objects[i] ? static_cast<const T*>(objects[i])->T::getValue() : 0;
+            }
+        }
+
+        // Direct implementation for a concrete type, or nullptr if unknown
+        GetValuesFn getValuesFor(const std::type_info& type) {
+            if (type == typeid(SharedWorker)) {
+                return &getValuesAs<SharedWorker>;
+            }
+            #define WEAK_SYMBOL_MATCH_TEMPLATED_WORKER(Type, Name) \
+                if (type == typeid(TemplatedWorker<Type>)) return &getValuesAs<TemplatedWorker<Type>>;
+            WEAK_SYMBOL_TEMPLATED_WORKER_TYPES(WEAK_SYMBOL_MATCH_TEMPLATED_WORKER)
+            #undef WEAK_SYMBOL_MATCH_TEMPLATED_WORKER
+            return nullptr;
+        }
+
+        // First non-null object if all non-null objects share its vptr
+        IBaseObject* homogeneousSample(IBaseObject* const* objects, std::size_t count) {
+            IBaseObject* sample = nullptr;
+            const void* vptr = nullptr;
+            for (std::size_t i = 0; i < count; ++i) {
+                if (!objects[i]) continue;
+                if (!sample) {
+                    sample = objects[i];
+                    vptr = vptrOf(sample);
+                } else if (vptrOf(objects[i]) != vptr) {
+                    return nullptr;
+                }
+            }
+            return sample;
+        }
+
+        // Per-group kernels; the direct ones are statically bound to T
+        struct GroupKernels {
+            void (*readyFlags)(IBaseObject* const*, const std::size_t*, std::size_t, std::size_t, bool*);
+            void (*performActions)(IBaseObject* const*, const std::size_t*, std::size_t, std::size_t);
+        };
+
+        template<typename T>
+        struct DirectKernels {
+            static void readyFlags(IBaseObject* const* objects, const std::size_t* indices,
+                                   std::size_t begin, std::size_t end, bool* out) {
+                forEachMember(indices, begin, end, [=](std::size_t i) {
+                    out[i] = static_cast<const T*>(objects[i])->T::isReady();
+                });
+            }
+            
+            static void performActions(IBaseObject* const* objects, const std::size_t* indices,
+                                       std::size_t begin, std::size_t end) {
+                forEachMember(indices, begin, end, [=](std::size_t i) {
+                    static_cast<T*>(objects[i])->T::performAction();
+                });
+            }
+            
+            static const GroupKernels kernels;
+        };
+
+        template<typename T>
+        const GroupKernels DirectKernels<T>::kernels = {
+            &DirectKernels<T>::readyFlags, &DirectKernels<T>::performActions
+        };
+
+        // Direct kernels for a group's type, or nullptr if unknown or the
+        // group is the mixed overflow group
+        const GroupKernels* directKernelsFor(const TypeGroup& group) {
+            if (!group.sample) return nullptr;
+            const std::type_info& type = typeid(*group.sample);
+            if (type == typeid(SharedWorker)) {
+                return &DirectKernels<SharedWorker>::kernels;
+            }
+            #define WEAK_SYMBOL_MATCH_TEMPLATED_WORKER(Type, Name) \
+                if (type == typeid(TemplatedWorker<Type>)) return &DirectKernels<TemplatedWorker<Type>>::kernels;
+            WEAK_SYMBOL_TEMPLATED_WORKER_TYPES(WEAK_SYMBOL_MATCH_TEMPLATED_WORKER)
+            #undef WEAK_SYMBOL_MATCH_TEMPLATED_WORKER
+            return nullptr;
+        }
+
+        // Members of a typed group share a dynamic type, so the AbstractWorker
+        // adjustment found for the sample applies to every one of them; the
+        // overflow group casts each member
+        void virtualReadyFlags(const TypeGroup& group, IBaseObject* const* objects,
+                               const std::size_t* indices, bool* out) {
+            if (!group.sample) {
+                forEachMember(indices, group.begin, group.end, [=](std::size_t i) {
+                    AbstractWorker* worker = cachedCast<AbstractWorker>(objects[i]);
+                    out[i] = worker && worker->isReady();
+                });
+                return;
+            }
+            AbstractWorker* sampleWorker = cachedCast<AbstractWorker>(group.sample);
+            const std::ptrdiff_t adjust = sampleWorker
+                ? reinterpret_cast<char*>(sampleWorker) - reinterpret_cast<char*>(group.sample) : 0;
+            forEachMember(indices, group.begin, group.end, [=](std::size_t i) {
+                out[i] = sampleWorker &&
+                    reinterpret_cast<AbstractWorker*>(reinterpret_cast<char*>(objects[i]) + adjust)->isReady();
+            });
+        }
+
+        void virtualPerformActions(IBaseObject* const* objects, const std::size_t* indices,
+                                   std::size_t begin, std::size_t end) {
+            forEachMember(indices, begin, end, [=](std::size_t i) {
+                objects[i]->performAction();
+            });
+        }
+
+        // Null entries are not members of any group
+        template<typename T>
+        void fillNulls(IBaseObject* const* objects, std::size_t count, T* out, T value) {
+            for (std::size_t i = 0; i < count; ++i) {
+                if (!objects[i]) out[i] = value;
+            }
+        }
+
+    } // namespace
+
+    void getValues(IBaseObject* const* objects, std::size_t count, int* out) {
+        if (!objects || !out) return;
+        
+        GetValuesFn direct = nullptr;
+        if (IBaseObject* sample = homogeneousSample(objects, count)) {
+            direct = getValuesFor(typeid(*sample));
+        }
+        (direct ? direct : &getValuesVirtual)(objects, count, out);
+    }
+
+    void getReadyFlags(IBaseObject* const* objects, std::size_t count, bool* out) {
+        if (!objects || !out) return;
+        
+        forEachGroup(objects, count, [=](const TypeGroup& group, const std::size_t* indices) {
+            if (const GroupKernels* direct = directKernelsFor(group)) {
+                direct->readyFlags(objects, indices, group.begin, group.end, out);
+            } else {
+                virtualReadyFlags(group, objects, indices, out);
+            }
+        });
+        fillNulls(objects, count, out, false);
+    }
+
+    void performActions(IBaseObject* const* objects, std::size_t count) {
+        if (!objects) return;
+        
+        forEachGroup(objects, count, [=](const TypeGroup& group, const std::size_t* indices) {
+            const GroupKernels* direct = directKernelsFor(group);
+            (direct ? direct->performActions : &virtualPerformActions)(objects, indices, group.begin, group.end);
+        });
+    }
+
+} // namespace WeakSymbolExample
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "../include/base_types.h"
+#include <cstddef>
+
+namespace WeakSymbolExample {
+
+    // Batch calls over IBaseObject pointers created on either side
+    // None of them allocate. Objects of SharedWorker or a listed
+    // TemplatedWorker<T> call the final implementation directly (no virtual
+    // call, inlinable); other types use virtual dispatch. Results are written
+    // to the caller's positions.
+
+    // out[i] = objects[i]->getValue(), or 0 for null entries
+    // A batch of one dynamic type is resolved once and run as a single
+    // direct loop; anything else is one pass of virtual calls, since the
+    // getters are too cheap for grouping to pay off
+    API_EXPORT void getValues(IBaseObject* const* objects, std::size_t count, int* out);
+
+    // The batch calls below group each chunk of up to 256 objects by dynamic
+    // type (vtable pointer) and run every group as one homogeneous loop, so
+    // the indirect branch stays predictable and only one implementation is
+    // hot at a time. A chunk with more than 8 types puts the rest in one
+    // mixed group that runs last with per-object virtual calls
+
+    // out[i] = isReady() for AbstractWorkers, false for other objects and nulls
+    API_EXPORT void getReadyFlags(IBaseObject* const* objects, std::size_t count, bool* out);
+
+    // performAction() on every non-null object, one type group at a time
+    // Within a chunk, groups run in order of first appearance and objects in
+    // input order within a group; chunks run in input order
+    API_EXPORT void performActions(IBaseObject* const* objects, std::size_t count);
+
+} // namespace WeakSymbolExample
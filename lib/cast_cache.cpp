@@ -0,0 +1,63 @@
+#include "cast_cache.h"
+
+namespace WeakSymbolExample {
+
+    namespace {
+
+        // Direct-mapped table; a collision simply evicts the previous entry
+        constexpr unsigned kCacheBits = 8;
+        constexpr std::size_t kCacheSize = std::size_t(1) << kCacheBits;
+
+        // The name() pointers are stored as well: once a library unloads, its
+        // type_info addresses can be reused by another type, whose name lives
+        // elsewhere, so a stale offset is never applied to it
+        struct CastEntry {
+            const std::type_info* dynamicType;
+            const std::type_info* targetType;
+            const char* dynamicName;
+            const char* targetName;
+            std::ptrdiff_t offset;
+        };
+
+        struct CastTable {
+            CastEntry entries[kCacheSize];
+        };
+
+        thread_local CastTable t_castTable = {};
+
+        // Keyed by type_info address: if the two sides end up with separate
+        // type_info objects for one type they simply occupy separate entries
+        CastEntry& slotFor(const std::type_info& dynamicType, const std::type_info& targetType) {
+            std::uint64_t key = reinterpret_cast<std::uintptr_t>(&dynamicType);
+            key = (key << 1) ^ reinterpret_cast<std::uintptr_t>(&targetType);
+            key *= 0x9E3779B97F4A7C15ull;  // Fibonacci hashing
+            return t_castTable.entries[key >> (64 - kCacheBits)];
+        }
+
+    } // namespace
+
+    bool lookupCastOffset(const std::type_info& dynamicType,
+                          const std::type_info& targetType,
+                          std::ptrdiff_t& offset) {
+        const CastEntry& entry = slotFor(dynamicType, targetType);
+        if (entry.dynamicType != &dynamicType || entry.targetType != &targetType ||
+            entry.dynamicName != dynamicType.name() || entry.targetName != targetType.name()) {
+            return false;
+        }
+        offset = entry.offset;
+        return true;
+    }
+
+    void storeCastOffset(const std::type_info& dynamicType,
+                         const std::type_info& targetType,
+                         std::ptrdiff_t offset) {
+        slotFor(dynamicType, targetType) = CastEntry{
+            &dynamicType, &targetType, dynamicType.name(), targetType.name(), offset
+        };
+    }
+
+    void clearCastCache() {
+        t_castTable = CastTable{};
+    }
+
+} // namespace WeakSymbolExample
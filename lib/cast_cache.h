@@ -0,0 +1,50 @@
+#pragma once
+
+#include "../include/base_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <typeinfo>
+
+namespace WeakSymbolExample {
+
+    // Offset recorded for (dynamic type, target type) pairs whose cast fails
+    constexpr std::ptrdiff_t kCastFailed = PTRDIFF_MIN;
+
+    // Cast cache owned by the DLL and shared by host and DLL callers
+    // Entries map (type_info of the most-derived object, target type_info) to
+    // the pointer adjustment dynamic_cast produced from the IBaseObject subobject
+    // Each thread has its own table, so lookups never take a lock; entries
+    // also match on the type_info name() pointers, so a type_info address
+    // reused after a library unloads never hits a stale entry
+    API_EXPORT bool lookupCastOffset(const std::type_info& dynamicType,
+                                     const std::type_info& targetType,
+                                     std::ptrdiff_t& offset);
+    API_EXPORT void storeCastOffset(const std::type_info& dynamicType,
+                                    const std::type_info& targetType,
+                                    std::ptrdiff_t offset);
+    
+    // Clears the calling thread's table only; other threads keep theirs
+    API_EXPORT void clearCastCache();
+
+    // Drop-in replacement for dynamic_cast<Target*>(obj)
+    // Valid because IBaseObject is a unique, non-virtual base throughout the
+    // hierarchy, so the adjustment depends only on the dynamic type
+    template<typename Target>
+    Target* cachedCast(IBaseObject* obj) {
+        if (!obj) return nullptr;
+
+        const std::type_info& dynamicType = typeid(*obj);
+        std::ptrdiff_t offset;
+        if (!lookupCastOffset(dynamicType, typeid(Target), offset)) {
+            Target* result = dynamic_cast<Target*>(obj);
+            offset = result ? reinterpret_cast<char*>(result) - reinterpret_cast<char*>(obj)
+                            : kCastFailed;
+            storeCastOffset(dynamicType, typeid(Target), offset);
+            return result;
+        }
+
+        if (offset == kCastFailed) return nullptr;
+        return reinterpret_cast<Target*>(reinterpret_cast<char*>(obj) + offset);
+    }
+
+} // namespace WeakSymbolExample
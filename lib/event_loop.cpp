@@ -0,0 +1,109 @@
+#include "event_loop.h"
+#include <deque>
+#include <exception>
+#include <unordered_set>
+#include <vector>
+
+namespace WeakSymbolExample {
+
+    namespace {
+
+        thread_local EventLoop* s_currentLoop = nullptr;
+
+        // Makes a loop current for the duration of run(); nested runs restore
+        // the outer loop
+        class CurrentLoopScope {
+        public:
+            explicit CurrentLoopScope(EventLoop* loop) : m_previous(s_currentLoop) {
+                s_currentLoop = loop;
+            }
+            
+            ~CurrentLoopScope() {
+                s_currentLoop = m_previous;
+            }
+            
+        private:
+            EventLoop* m_previous;
+        };
+
+    } // namespace
+
+    struct EventLoop::State {
+        std::deque<std::coroutine_handle<>> ready;
+        std::unordered_set<void*> spawned;              // Frames of unfinished spawned tasks
+        std::vector<WorkerTask::Handle> finished;       // Destroyed after they suspend
+        std::exception_ptr firstError;
+        std::size_t completed = 0;
+    };
+
+    EventLoop::EventLoop() : m_state(new State) {}
+
+    EventLoop::~EventLoop() {
+        for (void* frame : m_state->spawned) {
+            std::coroutine_handle<>::from_address(frame).destroy();
+        }
+    }
+
+    void EventLoop::spawn(WorkerTask task) {
+        WorkerTask::Handle handle = task.release();
+        if (!handle) return;
+        
+        handle.promise().onComplete = &EventLoop::onTaskComplete;
+        handle.promise().completionContext = this;
+        m_state->spawned.insert(handle.address());
+        m_state->ready.push_back(handle);
+    }
+
+    void EventLoop::spawn(AbstractWorker& worker) {
+        spawn(worker.doWorkAsync());
+    }
+
+    void EventLoop::schedule(std::coroutine_handle<> handle) {
+        m_state->ready.push_back(handle);
+    }
+
+    std::size_t EventLoop::run() {
+        CurrentLoopScope scope(this);
+        State& state = *m_state;
+        state.completed = 0;
+        
+        while (!state.ready.empty()) {
+            std::coroutine_handle<> next = state.ready.front();
+            state.ready.pop_front();
+            next.resume();
+            
+            for (WorkerTask::Handle task : state.finished) {
+                if (task.promise().exception && !state.firstError) {
+                    state.firstError = task.promise().exception;
+                }
+                task.destroy();
+            }
+            state.finished.clear();
+        }
+        
+        if (state.firstError) {
+            std::exception_ptr error = state.firstError;
+            state.firstError = nullptr;
+            std::rethrow_exception(error);
+        }
+        return state.completed;
+    }
+
+    std::size_t EventLoop::pendingTasks() const {
+        return m_state->spawned.size();
+    }
+
+    EventLoop* EventLoop::current() {
+        return s_currentLoop;
+    }
+
+    void EventLoop::onTaskComplete(void* loop, WorkerTask::Handle task) {
+        // The frame is suspended at its final point; run() destroys it once
+        // the resume that finished it has returned
+        State& state = *static_cast<EventLoop*>(loop)->m_state;
+        state.spawned.erase(task.address());
+        state.finished.push_back(task);
+        ++state.completed;
+    }
+
+} // namespace WeakSymbolExample
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "../include/base_types.h"
+
+// Only available with WEAK_SYMBOL_ENABLE_COROUTINES (C++20)
+#ifdef WEAK_SYMBOL_ENABLE_COROUTINES
+
+#include <coroutine>
+#include <cstddef>
+#include <memory>
+
+namespace WeakSymbolExample {
+
+    // Single-threaded scheduler for WorkerTask coroutines
+    // Spawned tasks and rescheduled coroutines are resumed in FIFO order on
+    // the thread calling run(), so thousands of workers can interleave on one
+    // thread as long as they suspend instead of blocking
+    class API_EXPORT EventLoop {
+    public:
+        EventLoop();
+        
+        // Destroys tasks that have not finished
+        ~EventLoop();
+        
+        EventLoop(const EventLoop&) = delete;
+        EventLoop& operator=(const EventLoop&) = delete;
+        
+        // Take ownership of a task and queue it to start on the next run()
+        void spawn(WorkerTask task);
+        
+        // Queue worker.doWorkAsync(); the worker must outlive the task
+        void spawn(AbstractWorker& worker);
+        
+        // Queue a suspended coroutine to be resumed by this loop
+        void schedule(std::coroutine_handle<> handle);
+        
+        // Resume queued coroutines until none is ready and return how many
+        // spawned tasks finished. Rethrows the first exception a spawned task
+        // ended with, once the queue has drained
+        std::size_t run();
+        
+        // Spawned tasks that have not finished yet
+        std::size_t pendingTasks() const;
+        
+        // Loop running on the calling thread, or nullptr
+        static EventLoop* current();
+        
+        // co_await EventLoop::yield(): let the other ready coroutines run first
+        // Continues immediately when no loop is running on this thread
+        struct YieldAwaiter {
+            bool await_ready() const noexcept {
+                return current() == nullptr;
+            }
+            
+            void await_suspend(std::coroutine_handle<> handle) const {
+                current()->schedule(handle);
+            }
+            
+            void await_resume() const noexcept {}
+        };
+        
+        static YieldAwaiter yield() noexcept {
+            return YieldAwaiter();
+        }
+        
+    private:
+        static void onTaskComplete(void* loop, WorkerTask::Handle task);
+        
+        struct State;
+        std::unique_ptr<State> m_state;
+    };
+
+} // namespace WeakSymbolExample
+
+#endif // WEAK_SYMBOL_ENABLE_COROUTINES
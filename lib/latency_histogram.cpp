@@ -0,0 +1,282 @@
+#include "latency_histogram.h"
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <unordered_map>
+
+namespace WeakSymbolExample {
+
+    namespace {
+
+        constexpr std::uint32_t kMaxTracePoints = 256;
+        constexpr std::uint32_t kInvalidTracePoint = UINT32_MAX;
+
+        // Measurement window; resetLatencyHistograms starts a new one. Live
+        // histograms are never cleared by another thread: each owner clears
+        // its own on its first record in a new window, and snapshots skip
+        // histograms still stamped with an old window
+        std::atomic<std::uint64_t> s_epoch(0);
+
+        // Written only by its owning thread (plain load + store, no locked
+        // read-modify-write); snapshots read it concurrently
+        struct Histogram {
+            std::atomic<std::uint64_t> buckets[LatencyBuckets::kCount];
+            std::atomic<std::uint64_t> count;
+            std::atomic<std::uint64_t> totalNs;
+            std::atomic<std::uint64_t> minNs;
+            std::atomic<std::uint64_t> maxNs;
+            std::atomic<std::uint64_t> epoch;  // Window the counts belong to
+            
+            Histogram() {
+                reset();
+                epoch.store(s_epoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+            }
+            
+            bool current() const {
+                return epoch.load(std::memory_order_acquire) == s_epoch.load(std::memory_order_acquire);
+            }
+            
+            void record(std::uint64_t ns) {
+                bump(buckets[LatencyBuckets::indexOf(ns)], 1);
+                bump(count, 1);
+                bump(totalNs, ns);
+                if (ns < minNs.load(std::memory_order_relaxed)) minNs.store(ns, std::memory_order_relaxed);
+                if (ns > maxNs.load(std::memory_order_relaxed)) maxNs.store(ns, std::memory_order_relaxed);
+            }
+            
+            void reset() {
+                for (std::atomic<std::uint64_t>& bucket : buckets) {
+                    bucket.store(0, std::memory_order_relaxed);
+                }
+                count.store(0, std::memory_order_relaxed);
+                totalNs.store(0, std::memory_order_relaxed);
+                minNs.store(UINT64_MAX, std::memory_order_relaxed);
+                maxNs.store(0, std::memory_order_relaxed);
+            }
+            
+            // Add this histogram's counts to a snapshot or to another histogram
+            template<typename Target>
+            void mergeInto(Target& target) const {
+                for (std::size_t i = 0; i < LatencyBuckets::kCount; ++i) {
+                    add(target.buckets[i], buckets[i].load(std::memory_order_relaxed));
+                }
+                add(target.count, count.load(std::memory_order_relaxed));
+                add(target.totalNs, totalNs.load(std::memory_order_relaxed));
+                lower(target.minNs, minNs.load(std::memory_order_relaxed));
+                raise(target.maxNs, maxNs.load(std::memory_order_relaxed));
+            }
+            
+        private:
+            static void bump(std::atomic<std::uint64_t>& counter, std::uint64_t amount) {
+                counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+            }
+            
+            static void add(std::uint64_t& target, std::uint64_t amount) { target += amount; }
+            static void add(std::atomic<std::uint64_t>& target, std::uint64_t amount) { bump(target, amount); }
+            
+            static void lower(std::uint64_t& target, std::uint64_t value) {
+                if (value < target) target = value;
+            }
+            static void lower(std::atomic<std::uint64_t>& target, std::uint64_t value) {
+                if (value < target.load(std::memory_order_relaxed)) target.store(value, std::memory_order_relaxed);
+            }
+            
+            static void raise(std::uint64_t& target, std::uint64_t value) {
+                if (value > target) target = value;
+            }
+            static void raise(std::atomic<std::uint64_t>& target, std::uint64_t value) {
+                if (value > target.load(std::memory_order_relaxed)) target.store(value, std::memory_order_relaxed);
+            }
+        };
+
+        class ThreadRecorder;
+
+        // Trace point names, live thread recorders and the totals of threads
+        // that have exited. Never destroyed, so threads exiting during static
+        // destruction can still retire their histograms
+        struct Registry {
+            std::mutex mutex;
+            std::vector<std::string> names;
+            std::unordered_map<std::string, std::uint32_t> ids;
+            std::vector<ThreadRecorder*> threads;
+            std::unique_ptr<Histogram> retired[kMaxTracePoints];
+        };
+
+        Registry& registry() {
+            static Registry* instance = new Registry;
+            return *instance;
+        }
+
+        // Per-thread histograms, allocated on a trace point's first call
+        class ThreadRecorder {
+        public:
+            ThreadRecorder() {
+                for (std::atomic<Histogram*>& histogram : m_histograms) {
+                    histogram.store(nullptr, std::memory_order_relaxed);
+                }
+                Registry& reg = registry();
+                std::lock_guard<std::mutex> lock(reg.mutex);
+                reg.threads.push_back(this);
+            }
+            
+            ~ThreadRecorder() {
+                Registry& reg = registry();
+                {
+                    std::lock_guard<std::mutex> lock(reg.mutex);
+                    for (std::uint32_t id = 0; id < kMaxTracePoints; ++id) {
+                        if (Histogram* histogram = m_histograms[id].load(std::memory_order_relaxed)) {
+                            if (histogram->current()) {
+                                if (!reg.retired[id]) reg.retired[id].reset(new Histogram);
+                                histogram->mergeInto(*reg.retired[id]);
+                            }
+                            delete histogram;
+                        }
+                    }
+                    for (auto it = reg.threads.begin(); it != reg.threads.end(); ++it) {
+                        if (*it == this) {
+                            reg.threads.erase(it);
+                            break;
+                        }
+                    }
+                }
+                s_destroyed = true;
+            }
+            
+            void record(std::uint32_t id, std::uint64_t ns) {
+                Histogram* histogram = m_histograms[id].load(std::memory_order_relaxed);
+                if (!histogram) {
+                    histogram = new Histogram;
+                    m_histograms[id].store(histogram, std::memory_order_release);
+                }
+                
+                // First record since a reset: clear the old window's counts
+                // before publishing the new epoch to snapshots
+                const std::uint64_t epoch = s_epoch.load(std::memory_order_acquire);
+                if (histogram->epoch.load(std::memory_order_relaxed) != epoch) {
+                    histogram->reset();
+                    histogram->epoch.store(epoch, std::memory_order_release);
+                }
+                histogram->record(ns);
+            }
+            
+            // Caller holds the registry mutex
+            const Histogram* histogram(std::uint32_t id) const {
+                return m_histograms[id].load(std::memory_order_acquire);
+            }
+            
+            // Set once the calling thread's recorder is gone, so calls made
+            // later during thread exit are not recorded
+            static thread_local bool s_destroyed;
+            
+        private:
+            std::atomic<Histogram*> m_histograms[kMaxTracePoints];
+        };
+
+        thread_local bool ThreadRecorder::s_destroyed = false;
+
+        ThreadRecorder& localRecorder() {
+            thread_local ThreadRecorder recorder;
+            return recorder;
+        }
+
+        void appendRow(std::string& out, const char* name, const char* count, const char* mean,
+                       const char* p50, const char* p90, const char* p99, const char* p999, const char* max) {
+            char row[256];
+            std::snprintf(row, sizeof(row), "%-48s %10s %10s %10s %10s %10s %10s %10s\n",
+                          name, count, mean, p50, p90, p99, p999, max);
+            out += row;
+        }
+
+    } // namespace
+
+    bool latencyHistogramsEnabled() {
+#ifdef WEAK_SYMBOL_ENABLE_LATENCY_HISTOGRAMS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    std::vector<LatencySnapshot> latencySnapshot() {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        
+        std::vector<LatencySnapshot> snapshots;
+        for (std::uint32_t id = 0; id < reg.names.size(); ++id) {
+            LatencySnapshot snapshot = {reg.names[id], 0, 0, UINT64_MAX, 0,
+                                        std::vector<std::uint64_t>(LatencyBuckets::kCount, 0)};
+            if (reg.retired[id]) reg.retired[id]->mergeInto(snapshot);
+            for (const ThreadRecorder* thread : reg.threads) {
+                const Histogram* histogram = thread->histogram(id);
+                if (histogram && histogram->current()) histogram->mergeInto(snapshot);
+            }
+            
+            // Owners keep recording while this runs; rank against the
+            // buckets that were read rather than a separately read count
+            snapshot.count = 0;
+            for (std::uint64_t bucket : snapshot.buckets) snapshot.count += bucket;
+            if (snapshot.count > 0) {
+                snapshots.push_back(std::move(snapshot));
+            }
+        }
+        return snapshots;
+    }
+
+    void resetLatencyHistograms() {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        
+        // Live histograms go stale and are cleared by their owners; a record
+        // that overlaps the reset may land in either window
+        s_epoch.fetch_add(1, std::memory_order_acq_rel);
+        for (std::uint32_t id = 0; id < reg.names.size(); ++id) {
+            if (reg.retired[id]) reg.retired[id]->reset();
+        }
+    }
+
+    std::string formatLatencyReport() {
+        if (!latencyHistogramsEnabled()) {
+            return "Latency histograms are disabled (build with -DWEAK_SYMBOL_ENABLE_LATENCY_HISTOGRAMS=ON)\n";
+        }
+        
+        std::string report;
+        appendRow(report, "entry point (ns)", "calls", "mean", "p50", "p90", "p99", "p99.9", "max");
+        for (const LatencySnapshot& snapshot : latencySnapshot()) {
+            char columns[7][24];
+            std::snprintf(columns[0], sizeof(columns[0]), "%llu", static_cast<unsigned long long>(snapshot.count));
+            std::snprintf(columns[1], sizeof(columns[1]), "%.0f", snapshot.meanNs());
+            const double quantiles[] = {0.5, 0.9, 0.99, 0.999};
+            for (int i = 0; i < 4; ++i) {
+                std::snprintf(columns[2 + i], sizeof(columns[2 + i]), "%llu",
+                              static_cast<unsigned long long>(snapshot.percentileNs(quantiles[i])));
+            }
+            std::snprintf(columns[6], sizeof(columns[6]), "%llu", static_cast<unsigned long long>(snapshot.maxNs));
+            appendRow(report, snapshot.name.c_str(), columns[0], columns[1], columns[2], columns[3],
+                      columns[4], columns[5], columns[6]);
+        }
+        return report;
+    }
+
+    namespace Detail {
+
+        std::uint32_t registerTracePoint(const std::string& name) {
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            auto found = reg.ids.find(name);
+            if (found != reg.ids.end()) return found->second;
+            if (reg.names.size() >= kMaxTracePoints) return kInvalidTracePoint;
+            
+            const std::uint32_t id = static_cast<std::uint32_t>(reg.names.size());
+            reg.names.push_back(name);
+            reg.ids.emplace(name, id);
+            return id;
+        }
+
+        void recordLatency(std::uint32_t tracePoint, std::uint64_t ns) {
+            if (tracePoint >= kMaxTracePoints || ThreadRecorder::s_destroyed) return;
+            localRecorder().record(tracePoint, ns);
+        }
+
+    } // namespace Detail
+
+} // namespace WeakSymbolExample
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "../include/base_types.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace WeakSymbolExample {
+
+    // Log-linear ("HDR-style") latency buckets in nanoseconds
+    // Values below 32 ns get a bucket each; every power of two above is split
+    // into 32 linear sub-buckets, so a bucket spans at most ~3% of its values.
+    // Everything from 2^40 ns (about 18 minutes) on shares the last bucket
+    namespace LatencyBuckets {
+
+        constexpr unsigned kSubBucketBits = 5;
+        constexpr std::uint64_t kSubBucketCount = std::uint64_t(1) << kSubBucketBits;
+        constexpr unsigned kMaxExponent = 40;
+        constexpr std::size_t kCount = kSubBucketCount + (kMaxExponent - kSubBucketBits) * kSubBucketCount;
+
+        inline std::size_t indexOf(std::uint64_t ns) {
+            if (ns < kSubBucketCount) return static_cast<std::size_t>(ns);
+            const unsigned exponent = 63 - static_cast<unsigned>(__builtin_clzll(ns));
+            if (exponent >= kMaxExponent) return kCount - 1;
+            const unsigned shift = exponent - kSubBucketBits;
+            const std::uint64_t subBucket = (ns >> shift) - kSubBucketCount;
+            return static_cast<std::size_t>(kSubBucketCount + shift * kSubBucketCount + subBucket);
+        }
+
+        // Largest value that falls into a bucket
+        inline std::uint64_t upperBound(std::size_t index) {
+            if (index < kSubBucketCount) return index;
+            const unsigned shift = static_cast<unsigned>((index - kSubBucketCount) / kSubBucketCount);
+            const std::uint64_t subBucket = (index - kSubBucketCount) % kSubBucketCount;
+            return ((kSubBucketCount + subBucket + 1) << shift) - 1;
+        }
+
+    } // namespace LatencyBuckets
+
+    // Latencies of one traced entry point, merged over all threads
+    struct LatencySnapshot {
+        std::string name;
+        std::uint64_t count;
+        std::uint64_t totalNs;
+        std::uint64_t minNs;
+        std::uint64_t maxNs;
+        std::vector<std::uint64_t> buckets;    // LatencyBuckets::kCount counts
+        
+        double meanNs() const {
+            return count ? static_cast<double>(totalNs) / static_cast<double>(count) : 0.0;
+        }
+        
+        // Upper bound of the bucket holding the q-quantile (0 < q <= 1),
+        // capped at maxNs; 0 when nothing was recorded
+        std::uint64_t percentileNs(double q) const {
+            if (count == 0) return 0;
+            std::uint64_t rank = static_cast<std::uint64_t>(q * static_cast<double>(count) + 0.999999);
+            if (rank < 1) rank = 1;
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < buckets.size(); ++i) {
+                seen += buckets[i];
+                if (seen >= rank) {
+                    const std::uint64_t bound = LatencyBuckets::upperBound(i);
+                    return bound < maxNs ? bound : maxNs;
+                }
+            }
+            return maxNs;
+        }
+    };
+
+    // Whether the library records latencies (WEAK_SYMBOL_ENABLE_LATENCY_HISTOGRAMS)
+    // When it does not, snapshots are empty and the report says so
+    API_EXPORT bool latencyHistogramsEnabled();
+
+    // Every entry point called at least once, in registration order
+    // Calls still in flight on other threads may or may not be included
+    API_EXPORT std::vector<LatencySnapshot> latencySnapshot();
+
+    // Clear all recorded latencies (entry points stay registered)
+    // Safe while other threads record; each thread clears its own counts on
+    // its next record, and a call overlapping the reset may land on either side
+    API_EXPORT void resetLatencyHistograms();
+
+    // Text table of count, mean, p50, p90, p99, p99.9 and max per entry point
+    API_EXPORT std::string formatLatencyReport();
+
+    namespace Detail {
+
+        // ID for a traced entry point; equal names share an ID
+        API_EXPORT std::uint32_t registerTracePoint(const std::string& name);
+
+        // Record one call on the calling thread's histogram
+        API_EXPORT void recordLatency(std::uint32_t tracePoint, std::uint64_t ns);
+
+        // Times the enclosing scope
+        class ScopedLatency {
+        public:
+            explicit ScopedLatency(std::uint32_t tracePoint)
+                : m_tracePoint(tracePoint), m_start(std::chrono::steady_clock::now()) {}
+            
+            ~ScopedLatency() {
+                const auto elapsed = std::chrono::steady_clock::now() - m_start;
+                recordLatency(m_tracePoint, static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+            }
+            
+            ScopedLatency(const ScopedLatency&) = delete;
+            ScopedLatency& operator=(const ScopedLatency&) = delete;
+            
+        private:
+            std::uint32_t m_tracePoint;
+            std::chrono::steady_clock::time_point m_start;
+        };
+
+    } // namespace Detail
+
+} // namespace WeakSymbolExample
+
+// Record the latency of the enclosing function under name (evaluated once)
+// Compiles to nothing unless WEAK_SYMBOL_ENABLE_LATENCY_HISTOGRAMS is defined
+#ifdef WEAK_SYMBOL_ENABLE_LATENCY_HISTOGRAMS
+    #define WEAK_SYMBOL_TRACE_CALL(name) \
+        static const std::uint32_t weakSymbolTracePoint = \
+            ::WeakSymbolExample::Detail::registerTracePoint(name); \
+        const ::WeakSymbolExample::Detail::ScopedLatency weakSymbolTraceScope(weakSymbolTracePoint)
+#else
+    #define WEAK_SYMBOL_TRACE_CALL(name) do {} while (0)
+#endif
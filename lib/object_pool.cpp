@@ -0,0 +1,135 @@
+#include "object_pool.h"
+#include <new>
+
+namespace WeakSymbolExample {
+
+    namespace {
+
+        // Size classes are multiples of the header alignment up to 256 bytes
+        // Larger blocks bypass the pool entirely
+        constexpr std::size_t kGranularity = alignof(std::max_align_t);
+        constexpr std::size_t kSizeClassCount = 256 / kGranularity;
+        constexpr std::size_t kMaxCachedPerClass = 4096;
+
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        struct FreeList {
+            FreeBlock* head = nullptr;
+            std::size_t count = 0;
+        };
+
+        std::size_t sizeClassIndex(std::size_t blockSize) {
+            return (blockSize + kGranularity - 1) / kGranularity - 1;
+        }
+
+        std::size_t sizeClassBytes(std::size_t index) {
+            return (index + 1) * kGranularity;
+        }
+
+        class ThreadObjectPool {
+        public:
+            ~ThreadObjectPool() {
+                trim();
+                s_destroyed = true;
+            }
+
+            void* allocate(std::size_t blockSize) {
+                const std::size_t index = sizeClassIndex(blockSize);
+                if (index >= kSizeClassCount) {
+                    return ::operator new(blockSize);
+                }
+
+                ++m_stats.allocations;
+                FreeList& list = m_lists[index];
+                if (FreeBlock* block = list.head) {
+                    list.head = block->next;
+                    --list.count;
+                    --m_stats.cachedBlocks;
+                    ++m_stats.reuses;
+                    return block;
+                }
+                return ::operator new(sizeClassBytes(index));
+            }
+
+            void release(void* block, std::size_t blockSize) {
+                const std::size_t index = sizeClassIndex(blockSize);
+                if (index >= kSizeClassCount || m_lists[index].count >= kMaxCachedPerClass) {
+                    ::operator delete(block);
+                    return;
+                }
+
+                FreeList& list = m_lists[index];
+                list.head = ::new (block) FreeBlock{list.head};
+                ++list.count;
+                ++m_stats.cachedBlocks;
+            }
+
+            void trim() {
+                for (FreeList& list : m_lists) {
+                    while (FreeBlock* block = list.head) {
+                        list.head = block->next;
+                        ::operator delete(block);
+                    }
+                    list.count = 0;
+                }
+                m_stats.cachedBlocks = 0;
+            }
+
+            const PoolStatistics& statistics() const {
+                return m_stats;
+            }
+
+            // Set once the calling thread's pool has been torn down, so that
+            // objects destroyed later during thread exit go straight to the heap
+            static thread_local bool s_destroyed;
+
+        private:
+            FreeList m_lists[kSizeClassCount];
+            PoolStatistics m_stats = {0, 0, 0};
+        };
+
+        thread_local bool ThreadObjectPool::s_destroyed = false;
+
+        ThreadObjectPool& localPool() {
+            thread_local ThreadObjectPool pool;
+            return pool;
+        }
+
+        void* poolAllocate(std::size_t blockSize) {
+            if (ThreadObjectPool::s_destroyed) {
+                return ::operator new(blockSize);
+            }
+            return localPool().allocate(blockSize);
+        }
+
+        void poolRelease(void* block, std::size_t blockSize) {
+            if (ThreadObjectPool::s_destroyed) {
+                ::operator delete(block);
+                return;
+            }
+            localPool().release(block, blockSize);
+        }
+
+    } // namespace
+
+    const ObjectAllocator& pooledObjectAllocator() {
+        static const ObjectAllocator allocator = { &poolAllocate, &poolRelease };
+        return allocator;
+    }
+
+    PoolStatistics pooledObjectStatistics() {
+        if (ThreadObjectPool::s_destroyed) {
+            return PoolStatistics{0, 0, 0};
+        }
+        return localPool().statistics();
+    }
+
+    void trimObjectPool() {
+        if (!ThreadObjectPool::s_destroyed) {
+            localPool().trim();
+        }
+    }
+
+} // namespace WeakSymbolExample
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "../include/base_types.h"
+#include <cstddef>
+
+namespace WeakSymbolExample {
+
+    // How the DLL factories allocate the objects they return
+    enum class AllocationPolicy {
+        Heap,    // Global operator new/delete
+        Pooled   // Per-thread free-list pool owned by libWeakSymbolLib
+    };
+
+    // Counters for the calling thread's pool
+    struct PoolStatistics {
+        std::size_t allocations;   // Blocks handed out by the pool
+        std::size_t reuses;        // Allocations satisfied from a free list
+        std::size_t cachedBlocks;  // Blocks currently sitting in free lists
+    };
+
+    // Allocator that draws from the calling thread's pool inside the DLL
+    // Blocks freed on another thread (or from the host) go to that thread's pool
+    API_EXPORT const ObjectAllocator& pooledObjectAllocator();
+
+    // Statistics and maintenance for the calling thread's pool
+    API_EXPORT PoolStatistics pooledObjectStatistics();
+    API_EXPORT void trimObjectPool();
+
+} // namespace WeakSymbolExample
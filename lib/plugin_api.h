@@ -0,0 +1,50 @@
+#pragma once
+
+#include "../include/base_types.h"
+#include <cstdint>
+#include <typeinfo>
+
+// ABI shared by WeakSymbolHost's plugin loader and the worker plugins it loads
+// A plugin is a shared library built like lib/shared_library.cpp (linked
+// against libWeakSymbolLib, default visibility, RTTI enabled) that exports
+// weak_symbol_plugin_descriptor()
+namespace WeakSymbolExample {
+
+    // Bumped whenever the descriptor or the IBaseObject layout changes
+    // (2: intrusive reference count). Coroutine builds set a flag bit since
+    // AbstractWorker::doWorkAsync() changes the vtable layout
+#ifdef WEAK_SYMBOL_ENABLE_COROUTINES
+    constexpr std::uint32_t kPluginAbiVersion = 2 | 0x10000;
+#else
+    constexpr std::uint32_t kPluginAbiVersion = 2;
+#endif
+
+    // Name of the entry point looked up with dlsym
+    constexpr const char* kPluginEntryPoint = "weak_symbol_plugin_descriptor";
+
+    // Everything the host needs from a plugin, filled in by the plugin
+    // Objects returned by the factories are released with destroyObject
+    struct PluginDescriptor {
+        std::uint32_t abiVersion;
+        const char* name;
+        
+        // Worker implementation provided by the plugin itself
+        AbstractWorker* (*createWorker)(int value);
+        
+        // Shared types created inside the plugin
+        AbstractWorker* (*createSharedWorker)(int value);
+        AbstractWorker* (*createTemplatedWorkerInt)(int value);
+        AbstractWorker* (*createTemplatedWorkerString)(const char* value);
+        void (*destroyObject)(IBaseObject* obj);
+        
+        // type_info objects as seen from inside the plugin, compared by address
+        // with the host's to prove that RTTI unified at load time
+        const std::type_info& (*sharedWorkerType)();
+        const std::type_info& (*templatedWorkerIntType)();
+        const std::type_info& (*templatedWorkerStringType)();
+    };
+
+    // Signature of the entry point
+    typedef const PluginDescriptor* (*PluginEntryPoint)();
+
+} // namespace WeakSymbolExample
@@ -1,13 +1,96 @@
 #include "shared_library.h"
 #include "../include/base_types.h"
 #include "../include/shared_class.h"
+#include "../include/worker_output.h"
+#include "latency_histogram.h"
+#include <algorithm>
 #include <iostream>
 #include <typeinfo>
 #include <memory>
 #include <sstream>
+#include <utility>
 
 namespace WeakSymbolExample {
 
+    namespace {
+        
+        // Source names used by the factories, interned once at load
+        const SourceName kDllSource("DLL");
+        const SourceName kDllBaseObjectSource("DLL-BaseObject");
+        // Overridden by the WeakSymbolLibNextGeneration build so hot reload
+        // tests can tell which build's factory created a worker
+#ifndef WEAK_SYMBOL_C_INTERFACE_SOURCE
+#define WEAK_SYMBOL_C_INTERFACE_SOURCE "DLL-C-Interface"
+#endif
+        const SourceName kDllCInterfaceSource(WEAK_SYMBOL_C_INTERFACE_SOURCE);
+        
+        // Allocate an object according to the requested policy
+        template<typename T, typename... Args>
+        std::unique_ptr<T> makeObject(AllocationPolicy policy, Args&&... args) {
+            if (policy == AllocationPolicy::Pooled) {
+                return std::unique_ptr<T>(new (pooledObjectAllocator()) T(std::forward<Args>(args)...));
+            }
+            return std::make_unique<T>(std::forward<Args>(args)...);
+        }
+        
+        // Factory logging goes through the worker output sink
+        template<typename T>
+        void logCreation(const char* what, const T& value, const char* quote = "") {
+            if (!workerOutputEnabled()) return;
+            WorkerLine line;
+            line << "DLL: Creating " << what << " with value " << quote << value << quote;
+            line.emit();
+        }
+        
+        // Display names for the generic factory's logging
+        template<typename T>
+        const char* templatedWorkerName();
+        
+        #define WEAK_SYMBOL_TEMPLATED_WORKER_NAME(Type, Name) \
+            template<> const char* templatedWorkerName<Type>() { return "TemplatedWorker<" Name ">"; }
+        WEAK_SYMBOL_TEMPLATED_WORKER_TYPES(WEAK_SYMBOL_TEMPLATED_WORKER_NAME)
+        #undef WEAK_SYMBOL_TEMPLATED_WORKER_NAME
+        
+#ifdef WEAK_SYMBOL_ENABLE_LATENCY_HISTOGRAMS
+        // Payload names for the generic factory's trace points
+        template<typename T>
+        const char* templatedPayloadName();
+        
+        #define WEAK_SYMBOL_TEMPLATED_PAYLOAD_NAME(Type, Name) \
+            template<> const char* templatedPayloadName<Type>() { return Name; }
+        WEAK_SYMBOL_TEMPLATED_WORKER_TYPES(WEAK_SYMBOL_TEMPLATED_PAYLOAD_NAME)
+        #undef WEAK_SYMBOL_TEMPLATED_PAYLOAD_NAME
+#endif
+        
+        // String payloads are logged in quotes
+        template<typename T>
+        const char* valueQuote(const T&) { return ""; }
+        const char* valueQuote(const std::string&) { return "'"; }
+        
+        // Untraced factory bodies, shared by entry points that create workers
+        // so each call records under one trace point
+        std::unique_ptr<AbstractWorker> makeDLLSharedWorker(int value, AllocationPolicy policy) {
+            logCreation("SharedWorker", value);
+            return makeObject<SharedWorker>(policy, value, kDllSource);
+        }
+        
+        template<typename T>
+        std::unique_ptr<AbstractWorker> makeDLLTemplatedWorker(const T& value) {
+            logCreation(templatedWorkerName<T>(), value, valueQuote(value));
+            return std::make_unique<TemplatedWorker<T>>(value, kDllSource);
+        }
+        
+        template<typename T, std::size_t N>
+        FixedVector<T, N> loadVector(const T* values) {
+            FixedVector<T, N> vector;
+            for (std::size_t i = 0; i < N; ++i) {
+                vector[i] = values[i];
+            }
+            return vector;
+        }
+        
+    } // namespace
+
     // Weak symbol implementations that will be defined in both DLL and host
     namespace Internal {
         
@@ -22,94 +105,159 @@ namespace WeakSymbolExample {
         
     } // namespace Internal
 
-    // Explicit template instantiations with weak symbols
-    template class __attribute__((weak)) TemplatedWorker<int>;
-    template class __attribute__((weak)) TemplatedWorker<std::string>;
+    // Explicit template instantiations with weak symbols, one per listed type
+    // GCC rejects the weak attribute on an instantiation (its explicit
+    // instantiations are already emitted as weak COMDAT definitions)
+#if defined(__clang__)
+    #define WEAK_SYMBOL_INSTANTIATE_TEMPLATED_WORKER(Type, Name) \
+        template class __attribute__((weak)) TemplatedWorker<Type>;
+#else
+    #define WEAK_SYMBOL_INSTANTIATE_TEMPLATED_WORKER(Type, Name) \
+        template class TemplatedWorker<Type>;
+#endif
+    WEAK_SYMBOL_TEMPLATED_WORKER_TYPES(WEAK_SYMBOL_INSTANTIATE_TEMPLATED_WORKER)
+    #undef WEAK_SYMBOL_INSTANTIATE_TEMPLATED_WORKER
 
     // Factory function implementations
-    std::unique_ptr<AbstractWorker> createDLLSharedWorker(int value) {
-        std::cout << "DLL: Creating SharedWorker with value " << value << std::endl;
-        return std::make_unique<SharedWorker>(value, "DLL");
+    std::unique_ptr<AbstractWorker> createDLLSharedWorker(int value, AllocationPolicy policy) {
+        WEAK_SYMBOL_TRACE_CALL("createDLLSharedWorker");
+        return makeDLLSharedWorker(value, policy);
+    }
+
+    std::unique_ptr<IBaseObject> createDLLBaseObject(int value, AllocationPolicy policy) {
+        WEAK_SYMBOL_TRACE_CALL("createDLLBaseObject");
+        logCreation("BaseObject (SharedWorker)", value);
+        return makeObject<SharedWorker>(policy, value, kDllBaseObjectSource);
+    }
+
+    template<typename T>
+    std::unique_ptr<AbstractWorker> createDLLTemplatedWorker(const T& value) {
+        WEAK_SYMBOL_TRACE_CALL(std::string("createDLLTemplatedWorker<") + templatedPayloadName<T>() + ">");
+        return makeDLLTemplatedWorker(value);
+    }
+    
+    AbstractWorker* createDLLSharedWorker(int value, WorkerArena& arena) {
+        WEAK_SYMBOL_TRACE_CALL("createDLLSharedWorker(arena)");
+        logCreation("SharedWorker", value);
+        return arena.create<SharedWorker>(value, kDllSource);
     }
 
-    std::unique_ptr<IBaseObject> createDLLBaseObject(int value) {
-        std::cout << "DLL: Creating BaseObject (SharedWorker) with value " << value << std::endl;
-        return std::make_unique<SharedWorker>(value, "DLL-BaseObject");
+    template<typename T>
+    AbstractWorker* createDLLTemplatedWorker(const T& value, WorkerArena& arena) {
+        WEAK_SYMBOL_TRACE_CALL(std::string("createDLLTemplatedWorker<") + templatedPayloadName<T>() + ">(arena)");
+        logCreation(templatedWorkerName<T>(), value, valueQuote(value));
+        return arena.create<TemplatedWorker<T>>(value, kDllSource);
     }
+    
+    #define WEAK_SYMBOL_INSTANTIATE_TEMPLATED_FACTORY(Type, Name) \
+        template std::unique_ptr<AbstractWorker> createDLLTemplatedWorker<Type>(const Type&); \
+        template AbstractWorker* createDLLTemplatedWorker<Type>(const Type&, WorkerArena&);
+    WEAK_SYMBOL_TEMPLATED_WORKER_TYPES(WEAK_SYMBOL_INSTANTIATE_TEMPLATED_FACTORY)
+    #undef WEAK_SYMBOL_INSTANTIATE_TEMPLATED_FACTORY
 
     std::unique_ptr<AbstractWorker> createDLLTemplatedWorkerInt(int value) {
-        std::cout << "DLL: Creating TemplatedWorker<int> with value " << value << std::endl;
-        return std::make_unique<TemplatedWorker<int>>(value, "DLL");
+        WEAK_SYMBOL_TRACE_CALL("createDLLTemplatedWorkerInt");
+        return makeDLLTemplatedWorker(value);
     }
 
     std::unique_ptr<AbstractWorker> createDLLTemplatedWorkerString(const std::string& value) {
-        std::cout << "DLL: Creating TemplatedWorker<string> with value '" << value << "'" << std::endl;
-        return std::make_unique<TemplatedWorker<std::string>>(value, "DLL");
+        WEAK_SYMBOL_TRACE_CALL("createDLLTemplatedWorkerString");
+        return makeDLLTemplatedWorker(value);
     }
 
+    // Untraced bodies of the RTTI helpers, shared with the C interface so
+    // each call records under the entry point the caller used
+    namespace {
+
+        bool checkDynamicCasts(IBaseObject* obj) {
+            if (!obj) return false;
+            
+            // Casts go through the shared cast cache; the first cast per
+            // (type, target) pair performs and records the real dynamic_cast
+            std::cout << "DLL: Testing dynamic_cast operations..." << std::endl;
+            
+            // Test casting to AbstractWorker
+            AbstractWorker* worker = cachedCast<AbstractWorker>(obj);
+            std::cout << "  -> dynamic_cast<AbstractWorker*>: " 
+                      << (worker ? "SUCCESS" : "FAILED") << std::endl;
+            
+            // Test casting to SharedWorker
+            SharedWorker* sharedWorker = cachedCast<SharedWorker>(obj);
+            std::cout << "  -> dynamic_cast<SharedWorker*>: " 
+                      << (sharedWorker ? "SUCCESS" : "FAILED") << std::endl;
+            
+            // Test casting to templated worker
+            auto* templatedInt = cachedCast<TemplatedWorker<int>>(obj);
+            std::cout << "  -> dynamic_cast<TemplatedWorker<int>*>: " 
+                      << (templatedInt ? "SUCCESS" : "FAILED") << std::endl;
+            
+            auto* templatedString = cachedCast<TemplatedWorker<std::string>>(obj);
+            std::cout << "  -> dynamic_cast<TemplatedWorker<string>*>: " 
+                      << (templatedString ? "SUCCESS" : "FAILED") << std::endl;
+            
+            return worker != nullptr;
+        }
+
+        std::string formatTypeInfo(IBaseObject* obj) {
+            if (!obj) return "null";
+            
+            const std::type_info& ti = typeid(*obj);
+            std::string result = "Type: ";
+            result += ti.name();
+            result += " (hash_code: 0x";
+            
+            // Convert hash_code to hex string
+            std::stringstream ss;
+            ss << std::hex << ti.hash_code();
+            result += ss.str();
+            result += ")";
+            
+            return result;
+        }
+
+        void writeObjectInfo(IBaseObject* obj) {
+            if (!obj) {
+                std::cout << "DLL: Object is null" << std::endl;
+                return;
+            }
+            
+            std::cout << "DLL: Object Information:" << std::endl;
+            std::cout << "  Type Name: " << obj->getTypeName() << std::endl;
+            std::cout << "  Description: " << obj->getDescription() << std::endl;
+            std::cout << "  Value: " << obj->getValue() << std::endl;
+            std::cout << "  RTTI Info: " << formatTypeInfo(obj) << std::endl;
+            
+            // Test virtual function call
+            std::cout << "  Calling performAction():" << std::endl;
+            obj->performAction();
+        }
+
+        void destroyObjects(IBaseObject* const* objects, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                delete objects[i];
+            }
+        }
+
+    } // namespace
+
     // RTTI testing functions
     bool testDynamicCast(IBaseObject* obj) {
-        if (!obj) return false;
-        
-        std::cout << "DLL: Testing dynamic_cast operations..." << std::endl;
-        
-        // Test casting to AbstractWorker
-        AbstractWorker* worker = dynamic_cast<AbstractWorker*>(obj);
-        std::cout << "  -> dynamic_cast<AbstractWorker*>: " 
-                  << (worker ? "SUCCESS" : "FAILED") << std::endl;
-        
-        // Test casting to SharedWorker
-        SharedWorker* sharedWorker = dynamic_cast<SharedWorker*>(obj);
-        std::cout << "  -> dynamic_cast<SharedWorker*>: " 
-                  << (sharedWorker ? "SUCCESS" : "FAILED") << std::endl;
-        
-        // Test casting to templated worker
-        auto* templatedInt = dynamic_cast<TemplatedWorker<int>*>(obj);
-        std::cout << "  -> dynamic_cast<TemplatedWorker<int>*>: " 
-                  << (templatedInt ? "SUCCESS" : "FAILED") << std::endl;
-        
-        auto* templatedString = dynamic_cast<TemplatedWorker<std::string>*>(obj);
-        std::cout << "  -> dynamic_cast<TemplatedWorker<string>*>: " 
-                  << (templatedString ? "SUCCESS" : "FAILED") << std::endl;
-        
-        return worker != nullptr;
+        WEAK_SYMBOL_TRACE_CALL("testDynamicCast");
+        return checkDynamicCasts(obj);
     }
 
     std::string getTypeInfo(IBaseObject* obj) {
-        if (!obj) return "null";
-        
-        const std::type_info& ti = typeid(*obj);
-        std::string result = "Type: ";
-        result += ti.name();
-        result += " (hash_code: 0x";
-        
-        // Convert hash_code to hex string
-        std::stringstream ss;
-        ss << std::hex << ti.hash_code();
-        result += ss.str();
-        result += ")";
-        
-        return result;
+        WEAK_SYMBOL_TRACE_CALL("getTypeInfo");
+        return formatTypeInfo(obj);
     }
 
     void printObjectInfo(IBaseObject* obj) {
-        if (!obj) {
-            std::cout << "DLL: Object is null" << std::endl;
-            return;
-        }
-        
-        std::cout << "DLL: Object Information:" << std::endl;
-        std::cout << "  Type Name: " << obj->getTypeName() << std::endl;
-        std::cout << "  Description: " << obj->getDescription() << std::endl;
-        std::cout << "  Value: " << obj->getValue() << std::endl;
-        std::cout << "  RTTI Info: " << getTypeInfo(obj) << std::endl;
-        
-        // Test virtual function call
-        std::cout << "  Calling performAction():" << std::endl;
-        obj->performAction();
+        WEAK_SYMBOL_TRACE_CALL("printObjectInfo");
+        writeObjectInfo(obj);
     }
 
     void demonstrateWeakSymbolUnification() {
+        WEAK_SYMBOL_TRACE_CALL("demonstrateWeakSymbolUnification");
         std::cout << "\nDLL: Demonstrating Weak Symbol Unification" << std::endl;
         std::cout << "===========================================" << std::endl;
         
@@ -119,7 +267,7 @@ namespace WeakSymbolExample {
         
         // Create instances and show they use the same type
         auto worker1 = std::make_unique<SharedWorker>(100, "DLL-Local");
-        auto worker2 = createDLLSharedWorker(200);
+        auto worker2 = makeDLLSharedWorker(200, AllocationPolicy::Heap);
         
         // Store references to avoid typeid side effect warnings
         const auto& w1_ref = *worker1;
@@ -131,7 +279,7 @@ namespace WeakSymbolExample {
         
         // Test template instances
         auto templated1 = std::make_unique<TemplatedWorker<int>>(123, "DLL-Direct");
-        auto templated2 = createDLLTemplatedWorkerInt(456);
+        auto templated2 = makeDLLTemplatedWorker(456);
         
         // Store references to avoid typeid side effect warnings
         const auto& t1_ref = *templated1;
@@ -145,19 +293,107 @@ namespace WeakSymbolExample {
     // C-style interface implementations
     extern "C" {
         
+        std::uint64_t weak_symbol_layout_stamp_c() {
+            return libraryLayoutStamp();
+        }
+        
         IBaseObject* create_dll_object_c(int value) {
-            return new SharedWorker(value, "DLL-C-Interface");
+            WEAK_SYMBOL_TRACE_CALL("create_dll_object_c");
+            return new SharedWorker(value, kDllCInterfaceSource);
+        }
+        
+        IBaseObject* create_dll_object_pooled_c(int value) {
+            WEAK_SYMBOL_TRACE_CALL("create_dll_object_pooled_c");
+            return new (pooledObjectAllocator()) SharedWorker(value, kDllCInterfaceSource);
+        }
+        
+        IBaseObject* create_dll_templated_worker_int_c(int value) {
+            WEAK_SYMBOL_TRACE_CALL("create_dll_templated_worker_int_c");
+            return new TemplatedWorker<int>(value, kDllCInterfaceSource);
+        }
+        
+        IBaseObject* create_dll_templated_worker_string_c(const char* value) {
+            WEAK_SYMBOL_TRACE_CALL("create_dll_templated_worker_string_c");
+            return new TemplatedWorker<std::string>(value ? value : "", kDllCInterfaceSource);
+        }
+        
+        IBaseObject* create_dll_templated_worker_int64_c(int64_t value) {
+            WEAK_SYMBOL_TRACE_CALL("create_dll_templated_worker_int64_c");
+            return new TemplatedWorker<std::int64_t>(value, kDllCInterfaceSource);
+        }
+        
+        IBaseObject* create_dll_templated_worker_double_c(double value) {
+            WEAK_SYMBOL_TRACE_CALL("create_dll_templated_worker_double_c");
+            return new TemplatedWorker<double>(value, kDllCInterfaceSource);
+        }
+        
+        IBaseObject* create_dll_templated_worker_float_c(float value) {
+            WEAK_SYMBOL_TRACE_CALL("create_dll_templated_worker_float_c");
+            return new TemplatedWorker<float>(value, kDllCInterfaceSource);
+        }
+        
+        IBaseObject* create_dll_templated_worker_float4_c(const float* values) {
+            WEAK_SYMBOL_TRACE_CALL("create_dll_templated_worker_float4_c");
+            if (!values) return nullptr;
+            return new TemplatedWorker<Float4>(loadVector<float, 4>(values), kDllCInterfaceSource);
+        }
+        
+        IBaseObject* create_dll_templated_worker_double4_c(const double* values) {
+            WEAK_SYMBOL_TRACE_CALL("create_dll_templated_worker_double4_c");
+            if (!values) return nullptr;
+            return new TemplatedWorker<Double4>(loadVector<double, 4>(values), kDllCInterfaceSource);
         }
         
         void destroy_dll_object_c(IBaseObject* obj) {
+            WEAK_SYMBOL_TRACE_CALL("destroy_dll_object_c");
             delete obj;
         }
         
+        void retain_dll_object_c(IBaseObject* obj) {
+            WEAK_SYMBOL_TRACE_CALL("retain_dll_object_c");
+            if (obj) obj->retain();
+        }
+        
+        void release_dll_object_c(IBaseObject* obj) {
+            WEAK_SYMBOL_TRACE_CALL("release_dll_object_c");
+            if (obj) obj->release();
+        }
+        
+        size_t create_dll_objects_c(const int* values, size_t count, IBaseObject** out) {
+            WEAK_SYMBOL_TRACE_CALL("create_dll_objects_c");
+            if (!values || !out) return 0;
+            
+            // Batch setup: the allocator is resolved once and objects
+            // come from the calling thread's pool
+            const ObjectAllocator& allocator = pooledObjectAllocator();
+            
+            size_t created = 0;
+            try {
+                for (; created < count; ++created) {
+                    out[created] = new (allocator) SharedWorker(values[created], kDllCInterfaceSource);
+                }
+            } catch (...) {
+                // Never let exceptions cross the C interface
+                destroyObjects(out, created);
+                std::fill(out, out + created, nullptr);
+                return 0;
+            }
+            return created;
+        }
+        
+        void destroy_dll_objects_c(IBaseObject* const* objects, size_t count) {
+            WEAK_SYMBOL_TRACE_CALL("destroy_dll_objects_c");
+            if (!objects) return;
+            destroyObjects(objects, count);
+        }
+        
         int test_dynamic_cast_c(IBaseObject* obj) {
-            return testDynamicCast(obj) ? 1 : 0;
+            WEAK_SYMBOL_TRACE_CALL("test_dynamic_cast_c");
+            return checkDynamicCasts(obj) ? 1 : 0;
         }
         
         const char* get_type_name_c(IBaseObject* obj) {
+            WEAK_SYMBOL_TRACE_CALL("get_type_name_c");
             if (!obj) return nullptr;
             
             // Note: This returns a pointer to a static string in the type_info
@@ -166,7 +402,8 @@ namespace WeakSymbolExample {
         }
         
         void print_object_info_c(IBaseObject* obj) {
-            printObjectInfo(obj);
+            WEAK_SYMBOL_TRACE_CALL("print_object_info_c");
+            writeObjectInfo(obj);
         }
         
     } // extern "C"
@@ -1,7 +1,19 @@
 #pragma once
 
 #include "../include/base_types.h"
+#include "../include/object_ref.h"
 #include "../include/shared_class.h"
+#include "bulk_dispatch.h"
+#include "cast_cache.h"
+#include "event_loop.h"
+#include "latency_histogram.h"
+#include "object_pool.h"
+#include "shared_worker_store.h"
+#include "worker_arena.h"
+#include "worker_executor.h"
+#include "worker_queue.h"
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 
 // C++ interface for the shared library
@@ -11,15 +23,35 @@ namespace WeakSymbolExample {
     // These functions return instances created within the DLL
     
     // Create a SharedWorker instance from within the DLL
-    API_EXPORT std::unique_ptr<AbstractWorker> createDLLSharedWorker(int value);
+    API_EXPORT std::unique_ptr<AbstractWorker> createDLLSharedWorker(int value,
+        AllocationPolicy policy = AllocationPolicy::Heap);
     
     // Create a SharedWorker instance and return as base pointer
-    API_EXPORT std::unique_ptr<IBaseObject> createDLLBaseObject(int value);
+    API_EXPORT std::unique_ptr<IBaseObject> createDLLBaseObject(int value,
+        AllocationPolicy policy = AllocationPolicy::Heap);
     
     // Create templated workers from within the DLL
     API_EXPORT std::unique_ptr<AbstractWorker> createDLLTemplatedWorkerInt(int value);
     API_EXPORT std::unique_ptr<AbstractWorker> createDLLTemplatedWorkerString(const std::string& value);
     
+    // Create a TemplatedWorker<T> for any type in WEAK_SYMBOL_TEMPLATED_WORKER_TYPES
+    // Only the listed instantiations exist in the DLL; other types fail to link
+    template<typename T>
+    API_EXPORT std::unique_ptr<AbstractWorker> createDLLTemplatedWorker(const T& value);
+    
+    // Arena variants: the worker lives until the arena is reset or destroyed
+    // The returned pointer is owned by the arena and must not be deleted
+    API_EXPORT AbstractWorker* createDLLSharedWorker(int value, WorkerArena& arena);
+    
+    template<typename T>
+    API_EXPORT AbstractWorker* createDLLTemplatedWorker(const T& value, WorkerArena& arena);
+    
+    #define WEAK_SYMBOL_EXTERN_TEMPLATED_FACTORY(Type, Name) \
+        extern template std::unique_ptr<AbstractWorker> createDLLTemplatedWorker<Type>(const Type&); \
+        extern template AbstractWorker* createDLLTemplatedWorker<Type>(const Type&, WorkerArena&);
+    WEAK_SYMBOL_TEMPLATED_WORKER_TYPES(WEAK_SYMBOL_EXTERN_TEMPLATED_FACTORY)
+    #undef WEAK_SYMBOL_EXTERN_TEMPLATED_FACTORY
+    
     // Utility functions to test RTTI across boundaries
     API_EXPORT bool testDynamicCast(IBaseObject* obj);
     API_EXPORT std::string getTypeInfo(IBaseObject* obj);
@@ -28,12 +60,72 @@ namespace WeakSymbolExample {
     // Function to demonstrate that weak symbols are unified
     API_EXPORT void demonstrateWeakSymbolUnification();
     
+    // Bumped whenever a virtual function of IBaseObject, AbstractWorker,
+    // SharedWorker or TemplatedWorker is added, removed or reordered
+    constexpr std::uint64_t kLibraryLayoutRevision = 1;
+    
+    namespace Detail {
+        constexpr std::uint64_t mixLayoutStamp(std::uint64_t stamp, std::uint64_t value) {
+            return (stamp ^ value) * 0x100000001b3ull;
+        }
+    } // namespace Detail
+    
+    // Layout of the shared types as compiled into this binary: the revision,
+    // the coroutine vtable slot and every shared type's size and alignment
+    // A host and a library with different stamps cannot share objects
+    constexpr std::uint64_t libraryLayoutStamp() {
+        std::uint64_t stamp = 0xcbf29ce484222325ull;
+        stamp = Detail::mixLayoutStamp(stamp, kLibraryLayoutRevision);
+#ifdef WEAK_SYMBOL_ENABLE_COROUTINES
+        stamp = Detail::mixLayoutStamp(stamp, 1);
+#endif
+        stamp = Detail::mixLayoutStamp(stamp, sizeof(IBaseObject));
+        stamp = Detail::mixLayoutStamp(stamp, sizeof(AbstractWorker));
+        stamp = Detail::mixLayoutStamp(stamp, sizeof(SharedWorker));
+        stamp = Detail::mixLayoutStamp(stamp, alignof(SharedWorker));
+        #define WEAK_SYMBOL_MIX_TEMPLATED_LAYOUT(Type, Name) \
+            stamp = Detail::mixLayoutStamp(stamp, sizeof(TemplatedWorker<Type>)); \
+            stamp = Detail::mixLayoutStamp(stamp, alignof(TemplatedWorker<Type>));
+        WEAK_SYMBOL_TEMPLATED_WORKER_TYPES(WEAK_SYMBOL_MIX_TEMPLATED_LAYOUT)
+        #undef WEAK_SYMBOL_MIX_TEMPLATED_LAYOUT
+        return stamp;
+    }
+    
     // C-style interface for testing (alternative approach)
     extern "C" {
+        // libraryLayoutStamp() of the library build; read with dlsym before
+        // any other entry point when loading a build at runtime
+        API_EXPORT std::uint64_t weak_symbol_layout_stamp_c();
+        
         // Create objects using C interface
         API_EXPORT IBaseObject* create_dll_object_c(int value);
+        API_EXPORT IBaseObject* create_dll_object_pooled_c(int value);
+        API_EXPORT IBaseObject* create_dll_templated_worker_int_c(int value);
+        API_EXPORT IBaseObject* create_dll_templated_worker_string_c(const char* value);
+        API_EXPORT IBaseObject* create_dll_templated_worker_int64_c(int64_t value);
+        API_EXPORT IBaseObject* create_dll_templated_worker_double_c(double value);
+        API_EXPORT IBaseObject* create_dll_templated_worker_float_c(float value);
+        
+        // Vector payloads read 4 elements from values; null values returns null
+        API_EXPORT IBaseObject* create_dll_templated_worker_float4_c(const float* values);
+        API_EXPORT IBaseObject* create_dll_templated_worker_double4_c(const double* values);
         API_EXPORT void destroy_dll_object_c(IBaseObject* obj);
         
+        // Shared ownership through the object's intrusive count (see ObjectRef)
+        // Created objects hold one reference, the caller's: release it instead
+        // of calling destroy_dll_object_c, retain to share, and the release
+        // that drops the last reference destroys the object. Null is ignored
+        API_EXPORT void retain_dll_object_c(IBaseObject* obj);
+        API_EXPORT void release_dll_object_c(IBaseObject* obj);
+        
+        // Bulk variants: one cross-library call per batch
+        // create_dll_objects_c fills out[0..count) and returns count; if any
+        // allocation fails it destroys what it created, nulls those entries
+        // and returns 0
+        // destroy_dll_objects_c skips null entries
+        API_EXPORT size_t create_dll_objects_c(const int* values, size_t count, IBaseObject** out);
+        API_EXPORT void destroy_dll_objects_c(IBaseObject* const* objects, size_t count);
+        
         // Test functions
         API_EXPORT int test_dynamic_cast_c(IBaseObject* obj);
         API_EXPORT const char* get_type_name_c(IBaseObject* obj);
@@ -0,0 +1,114 @@
+#include "shared_worker_store.h"
+
+namespace WeakSymbolExample {
+
+    std::size_t SharedWorkerStore::add(int value, SourceName source) {
+        m_values.push_back(value);
+        m_sources.push_back(source);
+        return m_values.size() - 1;
+    }
+
+    std::size_t SharedWorkerStore::add(int value, const std::string& source) {
+        return add(value, SourceName(source));
+    }
+
+    std::size_t SharedWorkerStore::add(const SharedWorker& worker) {
+        return add(worker.getValue(), worker.getSourceName());
+    }
+
+    void SharedWorkerStore::reserve(std::size_t count) {
+        m_values.reserve(count);
+        m_sources.reserve(count);
+    }
+
+    void SharedWorkerStore::clear() {
+        m_values.clear();
+        m_sources.clear();
+    }
+
+    std::size_t SharedWorkerStore::countReady() const {
+        // Branch-free so the compiler can vectorize the scan
+        const int* values = m_values.data();
+        const std::size_t count = m_values.size();
+        std::size_t ready = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            ready += values[i] > 0;
+        }
+        return ready;
+    }
+
+    std::int64_t SharedWorkerStore::sumValues() const {
+        const int* values = m_values.data();
+        const std::size_t count = m_values.size();
+        std::int64_t sum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            sum += values[i];
+        }
+        return sum;
+    }
+
+    std::vector<std::size_t> SharedWorkerStore::filterReady() const {
+        return filterByValue(1, INT32_MAX);
+    }
+
+    std::vector<std::size_t> SharedWorkerStore::filterBySource(SourceName source) const {
+        // Interned names compare by pointer
+        std::vector<std::size_t> matches;
+        const SourceName* sources = m_sources.data();
+        for (std::size_t i = 0; i < m_sources.size(); ++i) {
+            if (sources[i] == source) matches.push_back(i);
+        }
+        return matches;
+    }
+
+    std::vector<std::size_t> SharedWorkerStore::filterByValue(int minValue, int maxValue) const {
+        std::vector<std::size_t> matches;
+        const int* values = m_values.data();
+        for (std::size_t i = 0; i < m_values.size(); ++i) {
+            if (values[i] >= minValue && values[i] <= maxValue) matches.push_back(i);
+        }
+        return matches;
+    }
+
+    // Out of line so the view's vtable and type_info live in the library
+    SharedWorkerStore::View::~View() {}
+
+    std::string SharedWorkerStore::View::getTypeName() const {
+        return "SharedWorkerStore::View";
+    }
+
+    std::size_t SharedWorkerStore::View::describeTo(char* buffer, std::size_t capacity) const {
+        BufferWriter out(buffer, capacity);
+        out.append("SharedWorker created from ").append(getSource()).append(" with value ");
+        appendValue(out, getValue());
+        return out.length();
+    }
+
+    int SharedWorkerStore::View::getValue() const {
+        return m_store->value(m_index);
+    }
+
+    void SharedWorkerStore::View::performAction() {
+        if (!workerOutputEnabled()) return;
+        WorkerLine line;
+        line << "SharedWorker::performAction() called from "
+             << getSource() << " with value " << getValue();
+        line.emit();
+    }
+
+    void SharedWorkerStore::View::doWork() {
+        if (!workerOutputEnabled()) return;
+        WorkerLine line;
+        line << "SharedWorker::doWork() - Processing work from " << getSource();
+        line.emit();
+    }
+
+    bool SharedWorkerStore::View::isReady() const {
+        return getValue() > 0;
+    }
+
+    std::unique_ptr<SharedWorker> SharedWorkerStore::materialize(std::size_t index) const {
+        return std::make_unique<SharedWorker>(m_values[index], m_sources[index]);
+    }
+
+} // namespace WeakSymbolExample
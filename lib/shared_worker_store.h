@@ -0,0 +1,87 @@
+#pragma once
+
+#include "../include/base_types.h"
+#include "../include/shared_class.h"
+#include "../include/source_name.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace WeakSymbolExample {
+
+    // Struct-of-arrays storage for SharedWorker state
+    // Values and interned source names live in contiguous arrays so bulk
+    // queries scan memory linearly (and vectorize) instead of chasing one
+    // pointer per worker
+    class API_EXPORT SharedWorkerStore {
+    public:
+        // Non-owning IBaseObject view of one entry, built on demand
+        // Reads and writes go straight to the store's columns, so a view
+        // allocates nothing and the store sees every change. Valid while the
+        // entry exists and the store is not moved; views are stack or member
+        // objects and are never deleted through IBaseObject or held by ObjectRef
+        class API_EXPORT View : public AbstractWorker {
+        public:
+            View(SharedWorkerStore& store, std::size_t index)
+                : m_store(&store), m_index(index) {}
+            ~View() override;
+            
+            // Same behaviour as a SharedWorker with this entry's state
+            std::string getTypeName() const override;
+            std::size_t describeTo(char* buffer, std::size_t capacity) const override;
+            int getValue() const override;
+            void performAction() override;
+            void doWork() override;
+            bool isReady() const override;
+            
+            void setValue(int newValue) { m_store->setValue(m_index, newValue); }
+            const std::string& getSource() const { return m_store->source(m_index); }
+            SourceName getSourceName() const { return m_store->sourceName(m_index); }
+            std::size_t index() const { return m_index; }
+            
+        private:
+            SharedWorkerStore* m_store;
+            std::size_t m_index;
+        };
+        
+        // Append a worker and return its index
+        std::size_t add(int value, SourceName source);
+        std::size_t add(int value, const std::string& source);
+        std::size_t add(const SharedWorker& worker);
+
+        void reserve(std::size_t count);
+        void clear();
+        std::size_t size() const { return m_values.size(); }
+
+        // Per-worker access
+        int value(std::size_t index) const { return m_values[index]; }
+        void setValue(std::size_t index, int value) { m_values[index] = value; }
+        SourceName sourceName(std::size_t index) const { return m_sources[index]; }
+        const std::string& source(std::size_t index) const { return m_sources[index].str(); }
+
+        // Raw column access for callers that run their own scans
+        const int* values() const { return m_values.data(); }
+        const SourceName* sourceNames() const { return m_sources.data(); }
+
+        // Bulk queries (SharedWorker::isReady is value > 0)
+        std::size_t countReady() const;
+        std::int64_t sumValues() const;
+        std::vector<std::size_t> filterReady() const;
+        std::vector<std::size_t> filterBySource(SourceName source) const;
+        std::vector<std::size_t> filterByValue(int minValue, int maxValue) const;
+
+        // IBaseObject access to one entry without allocating
+        View view(std::size_t index) { return View(*this, index); }
+        
+        // Owning SharedWorker copy of one entry, for callers that need a
+        // heap object; it allocates and changes are not written back
+        std::unique_ptr<SharedWorker> materialize(std::size_t index) const;
+
+    private:
+        std::vector<int> m_values;
+        std::vector<SourceName> m_sources;
+    };
+
+} // namespace WeakSymbolExample
@@ -0,0 +1,28 @@
+#include "../include/source_name.h"
+#include <mutex>
+#include <unordered_set>
+
+namespace WeakSymbolExample {
+
+    namespace {
+
+        // Node-based set: element addresses stay valid as the table grows
+        struct SourceNameTable {
+            std::mutex mutex;
+            std::unordered_set<std::string> names;
+        };
+
+        SourceNameTable& table() {
+            static SourceNameTable instance;
+            return instance;
+        }
+
+    } // namespace
+
+    const std::string* internSourceName(const std::string& name) {
+        SourceNameTable& names = table();
+        std::lock_guard<std::mutex> lock(names.mutex);
+        return &*names.names.insert(name).first;
+    }
+
+} // namespace WeakSymbolExample
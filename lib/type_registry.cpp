@@ -0,0 +1,123 @@
+#include "../include/base_types.h"
+#include "../include/shared_class.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace WeakSymbolExample {
+
+    namespace {
+
+        // Registry of mangled type names; keyed by name rather than type_info
+        // address so host and DLL agree even when type_info is not unified
+        class TypeRegistry {
+        public:
+            TypeRegistry() {
+                // Well-known IDs, in the order of the enum in base_types.h
+                add(typeid(SharedWorker).name());
+                add(typeid(TemplatedWorker<int>).name());
+                add(typeid(TemplatedWorker<std::string>).name());
+            }
+
+            TypeId registerName(const char* mangledName) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto found = m_ids.find(mangledName);
+                if (found != m_ids.end()) {
+                    return found->second;
+                }
+                return add(mangledName);
+            }
+
+            const char* name(TypeId id) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (id == kInvalidTypeId || id > m_names.size()) {
+                    return nullptr;
+                }
+                return m_names[id - 1].c_str();
+            }
+
+        private:
+            TypeId add(const char* mangledName) {
+                m_names.emplace_back(mangledName);
+                const TypeId id = static_cast<TypeId>(m_names.size());
+                m_ids.emplace(m_names.back(), id);
+                return id;
+            }
+
+            std::mutex m_mutex;
+            std::deque<std::string> m_names;  // Stable storage for typeIdName
+            std::unordered_map<std::string, TypeId> m_ids;
+        };
+
+        TypeRegistry& registry() {
+            static TypeRegistry instance;
+            return instance;
+        }
+
+        // Build the registry while the library loads
+        const bool s_registryLoaded = (registry(), true);
+
+        // Open-addressed cache in front of the registry, shared by all threads
+        // Slots are claimed once and never evicted; when the probe window is
+        // full, lookups fall back to the registry
+        constexpr unsigned kTypeCacheBits = 8;
+        constexpr std::size_t kTypeCacheSize = std::size_t(1) << kTypeCacheBits;
+        constexpr std::size_t kTypeCacheProbes = 8;
+
+        struct TypeCacheEntry {
+            std::atomic<const std::type_info*> type;
+            std::atomic<const char*> name;  // Registry copy; published before id
+            std::atomic<TypeId> id;         // kInvalidTypeId until published
+        };
+
+        TypeCacheEntry s_typeCache[kTypeCacheSize];
+
+        std::size_t typeCacheSlot(const std::type_info& type) {
+            std::uint64_t key = reinterpret_cast<std::uintptr_t>(&type);
+            key *= 0x9E3779B97F4A7C15ull;  // Fibonacci hashing
+            return static_cast<std::size_t>(key >> (64 - kTypeCacheBits));
+        }
+
+    } // namespace
+
+    TypeId registerTypeId(const char* mangledName) {
+        if (!mangledName) return kInvalidTypeId;
+        return registry().registerName(mangledName);
+    }
+
+    const char* typeIdName(TypeId id) {
+        return registry().name(id);
+    }
+
+    TypeId typeIdOf(const std::type_info& type) {
+        const std::size_t first = typeCacheSlot(type);
+        for (std::size_t probe = 0; probe < kTypeCacheProbes; ++probe) {
+            TypeCacheEntry& entry = s_typeCache[(first + probe) & (kTypeCacheSize - 1)];
+            const std::type_info* cached = entry.type.load(std::memory_order_acquire);
+            if (!cached && entry.type.compare_exchange_strong(cached, &type,
+                                                              std::memory_order_acq_rel)) {
+                const TypeId id = registerTypeId(type.name());
+                entry.name.store(typeIdName(id), std::memory_order_relaxed);
+                entry.id.store(id, std::memory_order_release);
+                return id;
+            }
+            if (cached != &type) continue;
+
+            // Compare names as well: once an unloaded plugin's type_info
+            // address is reused, the slot no longer describes this type
+            const TypeId id = entry.id.load(std::memory_order_acquire);
+            if (id != kInvalidTypeId &&
+                std::strcmp(entry.name.load(std::memory_order_relaxed), type.name()) == 0) {
+                return id;
+            }
+            break;
+        }
+        return registerTypeId(type.name());
+    }
+
+} // namespace WeakSymbolExample
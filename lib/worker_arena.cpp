@@ -0,0 +1,84 @@
+#include "worker_arena.h"
+
+namespace WeakSymbolExample {
+
+    namespace {
+
+        constexpr std::size_t kAlignment = alignof(std::max_align_t);
+
+        std::size_t alignUp(std::size_t size) {
+            return (size + kAlignment - 1) & ~(kAlignment - 1);
+        }
+
+        // Arena blocks are released all at once by the arena
+        void arenaRelease(void*, std::size_t) {}
+
+    } // namespace
+
+    struct alignas(alignof(std::max_align_t)) WorkerArena::Chunk {
+        Chunk* next;
+        std::size_t capacity;
+        
+        char* begin() { return reinterpret_cast<char*>(this + 1); }
+        char* end() { return begin() + capacity; }
+    };
+
+    WorkerArena::WorkerArena(std::size_t chunkSize)
+        : m_chunkSize(alignUp(chunkSize ? chunkSize : kAlignment)), m_chunks(nullptr), m_current(nullptr),
+          m_cursor(nullptr), m_limit(nullptr), m_objectCount(0), m_bytesUsed(0), m_bytesReserved(0) {}
+
+    WorkerArena::~WorkerArena() {
+        reset();
+        while (Chunk* chunk = m_chunks) {
+            m_chunks = chunk->next;
+            ::operator delete(chunk);
+        }
+    }
+
+    void WorkerArena::reset() {
+        for (auto it = m_destructionList.rbegin(); it != m_destructionList.rend(); ++it) {
+            (*it)->~IBaseObject();
+        }
+        m_destructionList.clear();
+        
+        m_current = m_chunks;
+        m_cursor = m_current ? m_current->begin() : nullptr;
+        m_limit = m_current ? m_current->end() : nullptr;
+        m_objectCount = 0;
+        m_bytesUsed = 0;
+    }
+
+    void* WorkerArena::allocateObject(std::size_t size) {
+        const std::size_t blockSize = sizeof(Detail::AllocationHeader) + alignUp(size);
+        void* block = allocateBlock(blockSize);
+        Detail::AllocationHeader* header = ::new (block) Detail::AllocationHeader{&arenaRelease, blockSize};
+        return header + 1;
+    }
+
+    void* WorkerArena::allocateBlock(std::size_t blockSize) {
+        // Move on to the next chunk that fits, allocating one when none does;
+        // oversized blocks get a chunk of their own
+        while (static_cast<std::size_t>(m_limit - m_cursor) < blockSize) {
+            Chunk* next = m_current ? m_current->next : m_chunks;
+            while (next && next->capacity < blockSize) next = next->next;
+            
+            if (!next) {
+                const std::size_t capacity = blockSize > m_chunkSize ? blockSize : m_chunkSize;
+                next = ::new (::operator new(sizeof(Chunk) + capacity)) Chunk{nullptr, capacity};
+                Chunk** tail = &m_chunks;
+                while (*tail) tail = &(*tail)->next;
+                *tail = next;
+                m_bytesReserved += capacity;
+            }
+            m_current = next;
+            m_cursor = next->begin();
+            m_limit = next->end();
+        }
+        
+        void* block = m_cursor;
+        m_cursor += blockSize;
+        m_bytesUsed += blockSize;
+        return block;
+    }
+
+} // namespace WeakSymbolExample
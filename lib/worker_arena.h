@@ -0,0 +1,97 @@
+#pragma once
+
+#include "../include/base_types.h"
+#include "../include/shared_class.h"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace WeakSymbolExample {
+
+    // Whether the arena may skip T's destructor when it resets
+    // Destructors are virtual, so this cannot be std::is_trivially_destructible<T>;
+    // it holds for worker types whose destructor bodies are empty and whose
+    // members are all trivially destructible
+    template<typename T>
+    struct ArenaSkipsDestructor : std::false_type {};
+
+    template<>
+    struct ArenaSkipsDestructor<SharedWorker> : std::true_type {};
+
+    template<typename T>
+    struct ArenaSkipsDestructor<TemplatedWorker<T>> : std::is_trivially_destructible<T> {};
+
+    // Region allocator for request-lifetime objects
+    // Objects are bump-allocated from chunks owned by the arena and all of
+    // them are released at once by reset() or the destructor: destructors run
+    // (newest first) only for types that need them, then the chunks are
+    // rewound for reuse. Arena objects must never be deleted individually or
+    // held by ObjectRef. Not thread-safe; use one arena per thread or request
+    class API_EXPORT WorkerArena {
+    public:
+        explicit WorkerArena(std::size_t chunkSize = 16 * 1024);
+        ~WorkerArena();
+        
+        WorkerArena(const WorkerArena&) = delete;
+        WorkerArena& operator=(const WorkerArena&) = delete;
+        
+        // Construct a T in the arena: arena.create<SharedWorker>(42, "HOST")
+        template<typename T, typename... Args>
+        T* create(Args&&... args) {
+            static_assert(std::is_base_of<IBaseObject, T>::value, "arena objects derive from IBaseObject");
+            static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned arena object");
+            
+            void* place = allocateObject(sizeof(T));
+            if (ArenaSkipsDestructor<T>::value) {
+                T* obj = ::new (place) T(std::forward<Args>(args)...);
+                ++m_objectCount;
+                return obj;
+            }
+            
+            // Reserve the destructor slot first so a full list cannot leak the object
+            m_destructionList.push_back(nullptr);
+            try {
+                T* obj = ::new (place) T(std::forward<Args>(args)...);
+                m_destructionList.back() = obj;
+                ++m_objectCount;
+                return obj;
+            } catch (...) {
+                m_destructionList.pop_back();
+                throw;
+            }
+        }
+        
+        // Destroy every object and rewind; the chunks are kept for reuse
+        void reset();
+        
+        // Objects created since the last reset
+        std::size_t objectCount() const { return m_objectCount; }
+        
+        // Bytes handed out since the last reset, including allocation headers
+        std::size_t bytesUsed() const { return m_bytesUsed; }
+        
+        // Bytes held in chunks
+        std::size_t bytesReserved() const { return m_bytesReserved; }
+        
+    private:
+        struct Chunk;
+        
+        // Block for an object of the given size, preceded by an allocation
+        // header whose release is a no-op (the arena owns the memory)
+        void* allocateObject(std::size_t size);
+        void* allocateBlock(std::size_t blockSize);
+        
+        std::size_t m_chunkSize;
+        Chunk* m_chunks;        // All chunks, oldest first
+        Chunk* m_current;       // Chunk being bump-allocated from
+        char* m_cursor;
+        char* m_limit;
+        std::vector<IBaseObject*> m_destructionList;
+        std::size_t m_objectCount;
+        std::size_t m_bytesUsed;
+        std::size_t m_bytesReserved;
+    };
+
+} // namespace WeakSymbolExample
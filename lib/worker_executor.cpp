@@ -0,0 +1,201 @@
+#include "worker_executor.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace WeakSymbolExample {
+
+    namespace {
+
+        // Chunks per thread; more chunks balance better, fewer cost less locking
+        constexpr std::size_t kChunksPerThread = 4;
+
+        // Half-open range of indices into the current batch
+        struct Range {
+            std::size_t begin;
+            std::size_t end;
+        };
+
+        // Per-thread deque: the owner pops from the back, thieves take the front
+        struct RangeQueue {
+            std::mutex mutex;
+            std::deque<Range> ranges;
+        };
+
+    } // namespace
+
+    struct WorkerExecutor::State {
+        std::vector<std::unique_ptr<RangeQueue>> queues;
+        std::vector<std::thread> threads;
+
+        // Wake-up for idle threads
+        std::mutex wakeMutex;
+        std::condition_variable wake;
+        std::atomic<std::size_t> queuedRanges{0};
+        bool stopping = false;
+
+        // Current batch, one at a time
+        std::mutex runMutex;
+        AbstractWorker* const* workers = nullptr;
+        const CompletionCallback* onComplete = nullptr;
+        std::atomic<std::size_t> remaining{0};
+        std::atomic<std::size_t> ran{0};
+        std::mutex doneMutex;
+        std::condition_variable done;
+        std::exception_ptr error;
+
+        bool popLocal(std::size_t index, Range& range) {
+            RangeQueue& queue = *queues[index];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.ranges.empty()) return false;
+            range = queue.ranges.back();
+            queue.ranges.pop_back();
+            queuedRanges.fetch_sub(1);
+            return true;
+        }
+
+        bool steal(std::size_t start, Range& range) {
+            for (std::size_t i = 0; i < queues.size(); ++i) {
+                RangeQueue& queue = *queues[(start + i) % queues.size()];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (queue.ranges.empty()) continue;
+                range = queue.ranges.front();
+                queue.ranges.pop_front();
+                queuedRanges.fetch_sub(1);
+                return true;
+            }
+            return false;
+        }
+
+        void execute(const Range& range) {
+            std::size_t ranHere = 0;
+            for (std::size_t i = range.begin; i < range.end; ++i) {
+                AbstractWorker* worker = workers[i];
+                if (!worker) continue;
+                try {
+                    bool didRun = false;
+                    if (worker->isReady()) {
+                        worker->doWork();
+                        didRun = true;
+                        ++ranHere;
+                    }
+                    if (*onComplete) {
+                        (*onComplete)(*worker, didRun);
+                    }
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(doneMutex);
+                    if (!error) error = std::current_exception();
+                }
+            }
+
+            ran.fetch_add(ranHere);
+            if (remaining.fetch_sub(range.end - range.begin) == range.end - range.begin) {
+                std::lock_guard<std::mutex> lock(doneMutex);
+                done.notify_all();
+            }
+        }
+
+        void threadMain(std::size_t index) {
+            for (;;) {
+                Range range;
+                if (popLocal(index, range) || steal(index + 1, range)) {
+                    execute(range);
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(wakeMutex);
+                wake.wait(lock, [this]() { return stopping || queuedRanges.load() > 0; });
+                if (stopping) return;
+            }
+        }
+    };
+
+    WorkerExecutor::WorkerExecutor(std::size_t threadCount)
+        : m_state(new State) {
+        if (threadCount == 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            m_state->queues.emplace_back(new RangeQueue);
+        }
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            m_state->threads.emplace_back(&State::threadMain, m_state.get(), i);
+        }
+    }
+
+    WorkerExecutor::~WorkerExecutor() {
+        {
+            std::lock_guard<std::mutex> lock(m_state->wakeMutex);
+            m_state->stopping = true;
+        }
+        m_state->wake.notify_all();
+        for (std::thread& thread : m_state->threads) {
+            thread.join();
+        }
+    }
+
+    std::size_t WorkerExecutor::threadCount() const {
+        return m_state->threads.size();
+    }
+
+    std::size_t WorkerExecutor::run(const std::vector<WorkerPtr>& workers,
+                                    const CompletionCallback& onComplete) {
+        std::vector<AbstractWorker*> raw;
+        raw.reserve(workers.size());
+        for (const WorkerPtr& worker : workers) {
+            raw.push_back(worker.get());
+        }
+        return run(raw.data(), raw.size(), onComplete);
+    }
+
+    std::size_t WorkerExecutor::run(AbstractWorker* const* workers, std::size_t count,
+                                    const CompletionCallback& onComplete) {
+        if (!workers || count == 0) return 0;
+
+        State& state = *m_state;
+        std::lock_guard<std::mutex> runLock(state.runMutex);
+        state.workers = workers;
+        state.onComplete = &onComplete;
+        state.remaining = count;
+        state.ran = 0;
+        state.error = nullptr;
+
+        // Count the chunks before any becomes poppable: a pool thread still
+        // finishing the previous batch could otherwise pop one and decrement
+        // first, wrapping the count and leaving idle threads spinning
+        const std::size_t queueCount = state.queues.size();
+        const std::size_t chunk = std::max<std::size_t>(1, count / (queueCount * kChunksPerThread));
+        {
+            std::lock_guard<std::mutex> lock(state.wakeMutex);
+            state.queuedRanges.fetch_add((count + chunk - 1) / chunk);
+        }
+        
+        // Deal chunks round-robin into the per-thread queues
+        std::size_t chunks = 0;
+        for (std::size_t begin = 0; begin < count; begin += chunk, ++chunks) {
+            RangeQueue& queue = *state.queues[chunks % queueCount];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.ranges.push_back(Range{begin, std::min(begin + chunk, count)});
+        }
+        state.wake.notify_all();
+
+        // The caller steals alongside the pool threads
+        Range range;
+        while (state.steal(0, range)) {
+            state.execute(range);
+        }
+
+        std::unique_lock<std::mutex> lock(state.doneMutex);
+        state.done.wait(lock, [&state]() { return state.remaining.load() == 0; });
+        if (state.error) {
+            std::rethrow_exception(state.error);
+        }
+        return state.ran.load();
+    }
+
+} // namespace WeakSymbolExample
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "../include/base_types.h"
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace WeakSymbolExample {
+
+    // Work-stealing thread pool that runs AbstractWorker::doWork in parallel
+    // Host-created and DLL-created workers can be mixed freely in a batch
+    class API_EXPORT WorkerExecutor {
+    public:
+        // Called once per non-null worker after it has been visited
+        // ran is false when isReady() returned false and doWork was skipped
+        // Invoked on whichever thread processed the worker
+        using CompletionCallback = std::function<void(AbstractWorker& worker, bool ran)>;
+
+        // threadCount == 0 uses one thread per hardware core
+        explicit WorkerExecutor(std::size_t threadCount = 0);
+        ~WorkerExecutor();
+
+        WorkerExecutor(const WorkerExecutor&) = delete;
+        WorkerExecutor& operator=(const WorkerExecutor&) = delete;
+
+        std::size_t threadCount() const;
+
+        // Run isReady()/doWork() on every worker and block until all are done
+        // The calling thread helps with the batch; workers stay owned by the
+        // caller. Returns how many workers ran; rethrows the first exception
+        // thrown by a worker or callback once the whole batch has finished
+        // Batches run one at a time and run() is not reentrant: calling it
+        // from a worker's doWork() or a callback on the same executor deadlocks
+        std::size_t run(const std::vector<WorkerPtr>& workers,
+                        const CompletionCallback& onComplete = nullptr);
+        std::size_t run(AbstractWorker* const* workers, std::size_t count,
+                        const CompletionCallback& onComplete = nullptr);
+
+    private:
+        struct State;
+        std::unique_ptr<State> m_state;
+    };
+
+} // namespace WeakSymbolExample
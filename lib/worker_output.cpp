@@ -0,0 +1,124 @@
+#include "../include/worker_output.h"
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+namespace WeakSymbolExample {
+
+    namespace {
+
+        // Buffered lines are written once the per-thread buffer reaches this size
+        constexpr std::size_t kFlushThreshold = 16 * 1024;
+
+        class StdoutSink : public WorkerOutputSink {
+        public:
+            void write(const char* data, std::size_t length) override {
+                std::cout.write(data, static_cast<std::streamsize>(length));
+            }
+        };
+
+        StdoutSink s_stdoutSink;
+        std::atomic<WorkerOutputMode> s_mode(WorkerOutputMode::Immediate);
+        std::atomic<WorkerOutputSink*> s_sink(&s_stdoutSink);
+
+        std::mutex& sinkMutex() {
+            static std::mutex mutex;
+            return mutex;
+        }
+
+        void writeToSink(const char* data, std::size_t length) {
+            std::lock_guard<std::mutex> lock(sinkMutex());
+            s_sink.load(std::memory_order_acquire)->write(data, length);
+        }
+
+        // Text and newline under one lock so other threads' lines cannot interleave
+        void writeLineToSink(const char* text, std::size_t length) {
+            std::lock_guard<std::mutex> lock(sinkMutex());
+            WorkerOutputSink* sink = s_sink.load(std::memory_order_acquire);
+            sink->write(text, length);
+            sink->write("\n", 1);
+        }
+
+        // Per-thread line buffer, written out when full and at thread exit
+        class ThreadOutputBuffer {
+        public:
+            ThreadOutputBuffer() {
+                m_lines.reserve(kFlushThreshold + 256);
+            }
+
+            ~ThreadOutputBuffer() {
+                flush();
+                s_destroyed = true;
+            }
+
+            void append(const char* text, std::size_t length) {
+                m_lines.append(text, length);
+                m_lines.push_back('\n');
+                if (m_lines.size() >= kFlushThreshold) {
+                    flush();
+                }
+            }
+
+            void flush() {
+                if (m_lines.empty()) return;
+                writeToSink(m_lines.data(), m_lines.size());
+                m_lines.clear();
+            }
+
+            // Set once the thread's buffer is gone; later lines are written directly
+            static thread_local bool s_destroyed;
+
+        private:
+            std::string m_lines;
+        };
+
+        thread_local bool ThreadOutputBuffer::s_destroyed = false;
+
+        ThreadOutputBuffer& localBuffer() {
+            thread_local ThreadOutputBuffer buffer;
+            return buffer;
+        }
+
+    } // namespace
+
+    void setWorkerOutputMode(WorkerOutputMode mode) {
+        // Lines already buffered by this thread keep their order
+        flushWorkerOutput();
+        s_mode.store(mode, std::memory_order_release);
+    }
+
+    WorkerOutputMode workerOutputMode() {
+        return s_mode.load(std::memory_order_relaxed);
+    }
+
+    void setWorkerOutputSink(WorkerOutputSink* sink) {
+        flushWorkerOutput();
+        std::lock_guard<std::mutex> lock(sinkMutex());
+        s_sink.store(sink ? sink : &s_stdoutSink, std::memory_order_release);
+    }
+
+    void writeWorkerLine(const char* text, std::size_t length) {
+        switch (workerOutputMode()) {
+            case WorkerOutputMode::Immediate:
+                writeLineToSink(text, length);
+                break;
+            case WorkerOutputMode::Buffered:
+                if (!ThreadOutputBuffer::s_destroyed) {
+                    localBuffer().append(text, length);
+                    break;
+                }
+                writeLineToSink(text, length);
+                break;
+            case WorkerOutputMode::Discard:
+                break;
+        }
+    }
+
+    void flushWorkerOutput() {
+        if (!ThreadOutputBuffer::s_destroyed) {
+            localBuffer().flush();
+        }
+    }
+
+} // namespace WeakSymbolExample
@@ -0,0 +1,82 @@
+#include "worker_queue.h"
+
+namespace WeakSymbolExample {
+
+    namespace {
+
+        std::size_t roundUpToPowerOfTwo(std::size_t value) {
+            std::size_t result = 2;
+            while (result < value) result <<= 1;
+            return result;
+        }
+
+    } // namespace
+
+    WorkerQueue::WorkerQueue(std::size_t capacity)
+        : m_mask(roundUpToPowerOfTwo(capacity) - 1), m_enqueuePos(0), m_dequeuePos(0) {
+        m_cells.reset(new Cell[m_mask + 1]);
+        for (std::size_t i = 0; i <= m_mask; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+            m_cells[i].object = nullptr;
+        }
+    }
+
+    WorkerQueue::~WorkerQueue() {
+        while (IBaseObject* obj = tryPop()) {
+            delete obj;
+        }
+    }
+
+    bool WorkerQueue::tryPush(IBaseObject* obj) {
+        if (!obj) return false;
+        
+        std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = m_cells[pos & m_mask];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                // Slot free for this lap: claim the position, then publish
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.object = obj;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                // Slot still holds last lap's object: full
+                return false;
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    IBaseObject* WorkerQueue::tryPop() {
+        std::size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = m_cells[pos & m_mask];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                // Slot filled for this lap: claim it, then hand it to the next lap
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    IBaseObject* obj = cell.object;
+                    cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+                    return obj;
+                }
+            } else if (diff < 0) {
+                // Nothing published at this position yet: empty
+                return nullptr;
+            } else {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::size_t WorkerQueue::sizeApprox() const {
+        const std::size_t enqueued = m_enqueuePos.load(std::memory_order_relaxed);
+        const std::size_t dequeued = m_dequeuePos.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+} // namespace WeakSymbolExample
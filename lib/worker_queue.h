@@ -0,0 +1,66 @@
+#pragma once
+
+#include "../include/base_types.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace WeakSymbolExample {
+
+    // Bounded lock-free multi-producer/multi-consumer queue of IBaseObject*
+    // (Vyukov's array queue: each slot carries a sequence number that tells
+    // producers and consumers whose turn it is, so neither side takes a lock)
+    // Objects created by the host or the DLL can be pushed on one thread and
+    // popped on another; the queue owns the objects it holds and deletes any
+    // left in it when destroyed. Null pointers cannot be queued
+    class API_EXPORT WorkerQueue {
+    public:
+        // capacity is rounded up to a power of two (at least 2)
+        explicit WorkerQueue(std::size_t capacity);
+        ~WorkerQueue();
+        
+        WorkerQueue(const WorkerQueue&) = delete;
+        WorkerQueue& operator=(const WorkerQueue&) = delete;
+        
+        // Queue obj and take ownership; false (ownership kept) when full or null
+        bool tryPush(IBaseObject* obj);
+        
+        // Queue a unique_ptr's object; it is released only on success
+        template<typename T>
+        bool tryPush(std::unique_ptr<T>& obj) {
+            if (!tryPush(static_cast<IBaseObject*>(obj.get()))) return false;
+            obj.release();
+            return true;
+        }
+        
+        // Oldest object, owned by the caller, or nullptr when empty
+        IBaseObject* tryPop();
+        
+        BaseObjectPtr tryPopObject() {
+            return BaseObjectPtr(tryPop());
+        }
+        
+        std::size_t capacity() const { return m_mask + 1; }
+        
+        // Snapshot only; concurrent pushes and pops make it stale at once
+        std::size_t sizeApprox() const;
+        
+    private:
+        struct Cell {
+            std::atomic<std::size_t> sequence;
+            IBaseObject* object;
+        };
+        
+        // Producer and consumer positions on separate cache lines
+        static constexpr std::size_t kCacheLine = 64;
+        
+        std::unique_ptr<Cell[]> m_cells;
+        std::size_t m_mask;
+        char m_padding0[kCacheLine];
+        std::atomic<std::size_t> m_enqueuePos;
+        char m_padding1[kCacheLine - sizeof(std::atomic<std::size_t>)];
+        std::atomic<std::size_t> m_dequeuePos;
+        char m_padding2[kCacheLine - sizeof(std::atomic<std::size_t>)];
+    };
+
+} // namespace WeakSymbolExample
@@ -0,0 +1,107 @@
+#include "../include/base_types.h"
+#include "../include/shared_class.h"
+#include "../include/worker_output.h"
+#include "../lib/plugin_api.h"
+#include <typeinfo>
+
+// Sample worker plugin loaded by WeakSymbolHost at runtime
+// Built like libWeakSymbolLib (default visibility, RTTI) and linked against
+// it, so the shared types and their type_info unify with the host's
+namespace WeakSymbolExample {
+
+    namespace {
+
+        const SourceName kPluginSource("SamplePlugin");
+
+        // Worker implementation that neither the host nor the DLL knows about
+        class CountdownWorker : public AbstractWorker {
+        public:
+            explicit CountdownWorker(int remaining) : m_remaining(remaining) {}
+
+            std::string getTypeName() const override {
+                return "CountdownWorker";
+            }
+
+            std::size_t describeTo(char* buffer, std::size_t capacity) const override {
+                BufferWriter out(buffer, capacity);
+                out.append("CountdownWorker from ").append(kPluginSource.str()).append(" with ");
+                appendValue(out, m_remaining);
+                out.append(" steps remaining");
+                return out.length();
+            }
+
+            int getValue() const override {
+                return m_remaining;
+            }
+
+            void performAction() override {
+                if (!workerOutputEnabled()) return;
+                WorkerLine line;
+                line << "CountdownWorker::performAction() at " << m_remaining;
+                line.emit();
+            }
+
+            void doWork() override {
+                if (m_remaining > 0) --m_remaining;
+            }
+
+            bool isReady() const override {
+                return m_remaining > 0;
+            }
+
+        private:
+            int m_remaining;
+        };
+
+        AbstractWorker* createWorker(int value) {
+            return new CountdownWorker(value);
+        }
+
+        AbstractWorker* createSharedWorker(int value) {
+            return new SharedWorker(value, kPluginSource);
+        }
+
+        AbstractWorker* createTemplatedWorkerInt(int value) {
+            return new TemplatedWorker<int>(value, kPluginSource);
+        }
+
+        AbstractWorker* createTemplatedWorkerString(const char* value) {
+            return new TemplatedWorker<std::string>(value, kPluginSource);
+        }
+
+        void destroyObject(IBaseObject* obj) {
+            delete obj;
+        }
+
+        const std::type_info& sharedWorkerType() {
+            return typeid(SharedWorker);
+        }
+
+        const std::type_info& templatedWorkerIntType() {
+            return typeid(TemplatedWorker<int>);
+        }
+
+        const std::type_info& templatedWorkerStringType() {
+            return typeid(TemplatedWorker<std::string>);
+        }
+
+        const PluginDescriptor kDescriptor = {
+            kPluginAbiVersion,
+            "SamplePlugin",
+            &createWorker,
+            &createSharedWorker,
+            &createTemplatedWorkerInt,
+            &createTemplatedWorkerString,
+            &destroyObject,
+            &sharedWorkerType,
+            &templatedWorkerIntType,
+            &templatedWorkerStringType
+        };
+
+    } // namespace
+
+} // namespace WeakSymbolExample
+
+extern "C" API_EXPORT const WeakSymbolExample::PluginDescriptor* weak_symbol_plugin_descriptor() {
+    return &WeakSymbolExample::kDescriptor;
+}
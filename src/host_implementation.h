@@ -0,0 +1,22 @@
+#pragma once
+
+#include "../include/base_types.h"
+#include <memory>
+#include <string>
+
+// Host-side functions (defined in host_implementation.cpp)
+// Shared by the gtest suite and the benchmark executable
+namespace WeakSymbolExample {
+
+    // Host-side factory functions (for local creation)
+    std::unique_ptr<AbstractWorker> createHostSharedWorker(int value);
+    std::unique_ptr<IBaseObject> createHostBaseObject(int value);
+    std::unique_ptr<AbstractWorker> createHostTemplatedWorkerInt(int value);
+    std::unique_ptr<AbstractWorker> createHostTemplatedWorkerString(const std::string& value);
+
+    // Host-side RTTI testing functions
+    bool testHostDynamicCast(IBaseObject* obj);
+    std::string getHostTypeInfo(IBaseObject* obj);
+    void printHostObjectInfo(IBaseObject* obj);
+
+} // namespace WeakSymbolExample
@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+#include "../include/base_types.h"
+#include "../include/shared_class.h"
+#include "../lib/shared_library.h"
+#include "host_implementation.h"
+#include <memory>
+#include <string>
+#include <typeinfo>
+
+// Google Test Cases
+
+// Test suite for weak symbol functionality
+class WeakSymbolTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Any setup needed for tests
+    }
+    
+    void TearDown() override {
+        // Any cleanup needed after tests
+    }
+};
+
+// Test weak symbol function unification
+TEST_F(WeakSymbolTest, WeakFunctionUnification) {
+    // Test that weak symbol functions can be called
+    std::string result = WeakSymbolExample::Internal::getSharedFunctionResult();
+    EXPECT_FALSE(result.empty());
+    EXPECT_TRUE(result.find("Shared function result") != std::string::npos);
+    
+    // Test that performSharedOperation doesn't crash
+    EXPECT_NO_THROW(WeakSymbolExample::Internal::performSharedOperation(99));
+}
+
+// Test SharedWorker creation and type consistency
+TEST_F(WeakSymbolTest, SharedWorkerTypeConsistency) {
+    // Create instances using different methods
+    auto worker1 = std::make_unique<WeakSymbolExample::SharedWorker>(300, "HOST-Local");
+    auto worker2 = WeakSymbolExample::createHostSharedWorker(400);
+    
+    ASSERT_NE(worker1, nullptr);
+    ASSERT_NE(worker2, nullptr);
+    
+    // Test that both objects have the same type
+    const auto& w1_ref = *worker1;
+    const auto& w2_ref = *worker2;
+    
+    EXPECT_EQ(typeid(w1_ref), typeid(w2_ref));
+    EXPECT_EQ(worker1->getTypeName(), worker2->getTypeName());
+    EXPECT_EQ(worker1->getTypeName(), "SharedWorker");
+}
+
+// Test templated worker type consistency
+TEST_F(WeakSymbolTest, TemplatedWorkerTypeConsistency) {
+    // Test template instances
+    auto templated1 = std::make_unique<WeakSymbolExample::TemplatedWorker<int>>(789, "HOST-Direct");
+    auto templated2 = WeakSymbolExample::createHostTemplatedWorkerInt(101112);
+    
+    ASSERT_NE(templated1, nullptr);
+    ASSERT_NE(templated2, nullptr);
+    
+    // Test that both template instances have the same type
+    const auto& t1_ref = *templated1;
+    const auto& t2_ref = *templated2;
+    
+    EXPECT_EQ(typeid(t1_ref), typeid(t2_ref));
+    EXPECT_EQ(templated1->getTypeName(), templated2->getTypeName());
+    EXPECT_TRUE(templated1->getTypeName().find("TemplatedWorker") != std::string::npos);
+}
+
+// Test cross-boundary type unification
+TEST_F(WeakSymbolTest, CrossBoundaryTypeUnification) {
+    // Create objects from both host and DLL
+    auto hostWorker = WeakSymbolExample::createHostSharedWorker(500);
+    auto dllWorker = WeakSymbolExample::createDLLSharedWorker(600);
+    
+    ASSERT_NE(hostWorker, nullptr);
+    ASSERT_NE(dllWorker, nullptr);
+    
+    // Compare their types
+    const auto& hostWorker_ref = *hostWorker;
+    const auto& dllWorker_ref = *dllWorker;
+    
+    // Test that type_info objects are properly unified across boundaries
+    // This requires proper symbol unification to work correctly
+    EXPECT_EQ(typeid(hostWorker_ref), typeid(dllWorker_ref));
+    EXPECT_EQ(hostWorker->getTypeName(), dllWorker->getTypeName());
+}
+
+// Test dynamic casting functionality
+TEST_F(WeakSymbolTest, DynamicCastFunctionality) {
+    auto hostWorker = WeakSymbolExample::createHostSharedWorker(500);
+    auto dllWorker = WeakSymbolExample::createDLLSharedWorker(600);
+    
+    ASSERT_NE(hostWorker, nullptr);
+    ASSERT_NE(dllWorker, nullptr);
+    
+    // Test dynamic_cast between them
+    WeakSymbolExample::IBaseObject* hostBase = hostWorker.get();
+    WeakSymbolExample::IBaseObject* dllBase = dllWorker.get();
+    
+    // Try casting DLL object using host-side cast
+    WeakSymbolExample::SharedWorker* hostCastedDLL = dynamic_cast<WeakSymbolExample::SharedWorker*>(dllBase);
+    WeakSymbolExample::SharedWorker* dllCastedHost = dynamic_cast<WeakSymbolExample::SharedWorker*>(hostBase);
+    
+    EXPECT_NE(hostCastedDLL, nullptr) << "HOST dynamic_cast on DLL object should succeed";
+    EXPECT_NE(dllCastedHost, nullptr) << "DLL dynamic_cast on HOST object should succeed";
+    
+    // Test host-side dynamic cast function
+    EXPECT_TRUE(WeakSymbolExample::testHostDynamicCast(hostBase));
+    EXPECT_TRUE(WeakSymbolExample::testHostDynamicCast(dllBase));
+}
+
+// Test virtual function calls
+TEST_F(WeakSymbolTest, VirtualFunctionCalls) {
+    auto hostWorker = WeakSymbolExample::createHostSharedWorker(500);
+    auto dllWorker = WeakSymbolExample::createDLLSharedWorker(600);
+    
+    ASSERT_NE(hostWorker, nullptr);
+    ASSERT_NE(dllWorker, nullptr);
+    
+    // Test virtual function calls don't throw
+    EXPECT_NO_THROW(hostWorker->performAction());
+    EXPECT_NO_THROW(dllWorker->performAction());
+    EXPECT_NO_THROW(hostWorker->doWork());
+    EXPECT_NO_THROW(dllWorker->doWork());
+    
+    // Test that isReady works
+    EXPECT_TRUE(hostWorker->isReady());
+    EXPECT_TRUE(dllWorker->isReady());
+    
+    // Test getValue
+    EXPECT_EQ(hostWorker->getValue(), 500);
+    EXPECT_EQ(dllWorker->getValue(), 600);
+}
+
+// Test templated workers with different types
+TEST_F(WeakSymbolTest, TemplatedWorkerDifferentTypes) {
+    auto intWorker = WeakSymbolExample::createHostTemplatedWorkerInt(123);
+    auto stringWorker = WeakSymbolExample::createHostTemplatedWorkerString("test");
+    
+    ASSERT_NE(intWorker, nullptr);
+    ASSERT_NE(stringWorker, nullptr);
+    
+    // Test that different template types have different type names
+    EXPECT_NE(intWorker->getTypeName(), stringWorker->getTypeName());
+    EXPECT_TRUE(intWorker->getTypeName().find("TemplatedWorker") != std::string::npos);
+    EXPECT_TRUE(stringWorker->getTypeName().find("TemplatedWorker") != std::string::npos);
+    
+    // Test that they can be cast to AbstractWorker
+    WeakSymbolExample::AbstractWorker* intWorkerPtr = intWorker.get();
+    WeakSymbolExample::AbstractWorker* stringWorkerPtr = stringWorker.get();
+    
+    EXPECT_NE(intWorkerPtr, nullptr);
+    EXPECT_NE(stringWorkerPtr, nullptr);
+}
+
+// Test type information utilities
+TEST_F(WeakSymbolTest, TypeInformationUtilities) {
+    auto worker = WeakSymbolExample::createHostSharedWorker(100);
+    ASSERT_NE(worker, nullptr);
+    
+    WeakSymbolExample::IBaseObject* basePtr = worker.get();
+    
+    // Test getHostTypeInfo
+    std::string typeInfo = WeakSymbolExample::getHostTypeInfo(basePtr);
+    EXPECT_FALSE(typeInfo.empty());
+    EXPECT_TRUE(typeInfo.find("Type:") != std::string::npos);
+    EXPECT_TRUE(typeInfo.find("hash_code:") != std::string::npos);
+    
+    // Test with null pointer
+    std::string nullInfo = WeakSymbolExample::getHostTypeInfo(nullptr);
+    EXPECT_EQ(nullInfo, "null");
+}
+
+// Test base object interface
+TEST_F(WeakSymbolTest, BaseObjectInterface) {
+    auto baseObject = WeakSymbolExample::createHostBaseObject(200);
+    ASSERT_NE(baseObject, nullptr);
+    
+    // Test interface methods
+    EXPECT_FALSE(baseObject->getTypeName().empty());
+    EXPECT_FALSE(baseObject->getDescription().empty());
+    EXPECT_EQ(baseObject->getValue(), 200);
+    
+    // Test that it can be cast to SharedWorker
+    WeakSymbolExample::SharedWorker* sharedWorker = 
+        dynamic_cast<WeakSymbolExample::SharedWorker*>(baseObject.get());
+    EXPECT_NE(sharedWorker, nullptr);
+    
+    if (sharedWorker) {
+        EXPECT_EQ(sharedWorker->getSource(), "HOST-BaseObject");
+    }
+}
+
+// Test static methods
+TEST_F(WeakSymbolTest, StaticMethods) {
+    // Test static method call
+    std::string staticInfo = WeakSymbolExample::SharedWorker::getStaticInfo();
+    EXPECT_EQ(staticInfo, "SharedWorker static method");
+}
+
+// Test edge cases and error conditions
+TEST_F(WeakSymbolTest, EdgeCases) {
+    // Test testHostDynamicCast with null
+    EXPECT_FALSE(WeakSymbolExample::testHostDynamicCast(nullptr));
+    
+    // Test creating workers with edge values
+    auto zeroWorker = WeakSymbolExample::createHostSharedWorker(0);
+    ASSERT_NE(zeroWorker, nullptr);
+    EXPECT_FALSE(zeroWorker->isReady()); // Should be false for value 0
+    
+    auto negativeWorker = WeakSymbolExample::createHostSharedWorker(-1);
+    ASSERT_NE(negativeWorker, nullptr);
+    EXPECT_FALSE(negativeWorker->isReady()); // Should be false for negative value
+} 
\ No newline at end of file
@@ -0,0 +1,189 @@
+#include "library_reloader.h"
+#include <cstdlib>
+#include <dlfcn.h>
+#include <fstream>
+#include <unistd.h>
+
+namespace WeakSymbolExample {
+
+    // A private copy of the library opened with dlopen
+    // Resolves the C interface of lib/shared_library.h from that copy only
+    struct LibraryGeneration {
+        typedef IBaseObject* (*CreateInt)(int);
+        typedef IBaseObject* (*CreateString)(const char*);
+        typedef void (*Destroy)(IBaseObject*);
+        typedef std::uint64_t (*LayoutStamp)();
+        
+        LibraryGeneration(std::uint64_t number, std::string path, void* handle)
+            : number(number), path(std::move(path)), handle(handle) {}
+        
+        ~LibraryGeneration() {
+            dlclose(handle);
+        }
+        
+        LibraryGeneration(const LibraryGeneration&) = delete;
+        LibraryGeneration& operator=(const LibraryGeneration&) = delete;
+        
+        const std::uint64_t number;
+        const std::string path;
+        void* const handle;
+        LayoutStamp layoutStamp = nullptr;
+        CreateInt createSharedWorker = nullptr;
+        CreateInt createTemplatedWorkerInt = nullptr;
+        CreateString createTemplatedWorkerString = nullptr;
+        Destroy destroyObject = nullptr;
+    };
+
+    namespace {
+
+        void setError(std::string* error, const std::string& message) {
+            if (error) *error = message;
+        }
+
+        // Copy the library to a fresh temporary file and return its path
+        bool copyToTemporary(const std::string& source, std::uint64_t number,
+                             std::string& copyPath, std::string* error) {
+            const char* tmpdir = std::getenv("TMPDIR");
+            std::string pattern = std::string(tmpdir && *tmpdir ? tmpdir : "/tmp") +
+                                  "/WeakSymbolLib-gen" + std::to_string(number) + "-XXXXXX";
+            const int fd = mkstemp(&pattern[0]);
+            if (fd < 0) {
+                setError(error, "cannot create a temporary copy of " + source);
+                return false;
+            }
+            close(fd);
+            
+            std::ifstream in(source, std::ios::binary);
+            std::ofstream out(pattern, std::ios::binary | std::ios::trunc);
+            if (!in || !out || !(out << in.rdbuf())) {
+                unlink(pattern.c_str());
+                setError(error, "cannot copy " + source + " to " + pattern);
+                return false;
+            }
+            
+            copyPath = pattern;
+            return true;
+        }
+
+        template<typename Function>
+        bool resolve(void* handle, const char* name, Function& function) {
+            function = reinterpret_cast<Function>(dlsym(handle, name));
+            return function != nullptr;
+        }
+
+        ReloadableWorkerPtr adopt(IBaseObject* obj, std::shared_ptr<LibraryGeneration> generation) {
+            // The C interface only creates workers
+            return ReloadableWorkerPtr(static_cast<AbstractWorker*>(obj), GenerationDeleter(std::move(generation)));
+        }
+
+    } // namespace
+
+    void GenerationDeleter::operator()(AbstractWorker* worker) {
+        // Destroy through the generation that created the worker, then drop
+        // the reference; the last one unloads the generation
+        m_generation->destroyObject(worker);
+        m_generation.reset();
+    }
+
+    std::uint64_t GenerationDeleter::generation() const {
+        return m_generation ? m_generation->number : 0;
+    }
+
+    bool LibraryReloader::reload(std::string* error) {
+        std::uint64_t number;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            number = m_nextGeneration++;
+        }
+        
+        std::string copyPath;
+        if (!copyToTemporary(m_libraryPath, number, copyPath, error)) {
+            return false;
+        }
+        
+        // The mapping keeps the file contents alive, so the copy can be
+        // unlinked right away and never outlives the process
+        void* handle = dlopen(copyPath.c_str(), RTLD_NOW | RTLD_LOCAL);
+        unlink(copyPath.c_str());
+        if (!handle) {
+            const char* reason = dlerror();
+            setError(error, reason ? reason : "dlopen failed for " + copyPath);
+            return false;
+        }
+        
+        // Objects of every generation share the host's vtables and type_info,
+        // so a build whose shared types are laid out differently cannot be used
+        auto generation = std::make_shared<LibraryGeneration>(number, copyPath, handle);
+        if (!resolve(handle, "weak_symbol_layout_stamp_c", generation->layoutStamp)) {
+            setError(error, m_libraryPath + ": missing weak_symbol_layout_stamp_c");
+            return false;
+        }
+        if (generation->layoutStamp() != m_layoutStamp) {
+            setError(error, m_libraryPath + ": shared type layout differs from the host's");
+            return false;
+        }
+        if (!resolve(handle, "create_dll_object_c", generation->createSharedWorker) ||
+            !resolve(handle, "create_dll_templated_worker_int_c", generation->createTemplatedWorkerInt) ||
+            !resolve(handle, "create_dll_templated_worker_string_c", generation->createTemplatedWorkerString) ||
+            !resolve(handle, "destroy_dll_object_c", generation->destroyObject)) {
+            setError(error, m_libraryPath + ": missing WeakSymbolLib C interface");
+            return false;
+        }
+        
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_current = generation;
+        m_generations.push_back(generation);
+        return true;
+    }
+
+    std::uint64_t LibraryReloader::generation() const {
+        const auto generation = current();
+        return generation ? generation->number : 0;
+    }
+
+    std::size_t LibraryReloader::loadedGenerations() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::size_t loaded = 0;
+        for (auto it = m_generations.begin(); it != m_generations.end();) {
+            if (it->expired()) {
+                it = m_generations.erase(it);
+            } else {
+                ++loaded;
+                ++it;
+            }
+        }
+        return loaded;
+    }
+
+    std::string LibraryReloader::loadedPath() const {
+        const auto generation = current();
+        return generation ? generation->path : std::string();
+    }
+
+    ReloadableWorkerPtr LibraryReloader::createSharedWorker(int value) const {
+        auto generation = current();
+        if (!generation) return ReloadableWorkerPtr();
+        IBaseObject* obj = generation->createSharedWorker(value);
+        return adopt(obj, std::move(generation));
+    }
+
+    ReloadableWorkerPtr LibraryReloader::createTemplatedWorkerInt(int value) const {
+        auto generation = current();
+        if (!generation) return ReloadableWorkerPtr();
+        IBaseObject* obj = generation->createTemplatedWorkerInt(value);
+        return adopt(obj, std::move(generation));
+    }
+
+    ReloadableWorkerPtr LibraryReloader::createTemplatedWorkerString(const std::string& value) const {
+        auto generation = current();
+        if (!generation) return ReloadableWorkerPtr();
+        IBaseObject* obj = generation->createTemplatedWorkerString(value.c_str());
+        return adopt(obj, std::move(generation));
+    }
+
+    std::shared_ptr<LibraryGeneration> LibraryReloader::current() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_current;
+    }
+
+} // namespace WeakSymbolExample
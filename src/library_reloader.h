@@ -0,0 +1,95 @@
+#pragma once
+
+#include "../include/base_types.h"
+#include "../lib/shared_library.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Hot reload of libWeakSymbolLib without restarting the process
+namespace WeakSymbolExample {
+
+    // One loaded build of the library (defined in library_reloader.cpp)
+    struct LibraryGeneration;
+
+    // Deleter for workers created by a generation
+    // Each worker keeps its generation loaded; the generation is unloaded
+    // when its last worker is destroyed and the reloader has moved on
+    class GenerationDeleter {
+    public:
+        GenerationDeleter() {}
+        explicit GenerationDeleter(std::shared_ptr<LibraryGeneration> generation)
+            : m_generation(std::move(generation)) {}
+        
+        void operator()(AbstractWorker* worker);
+        
+        // Generation that created the worker, or 0 once it has been deleted
+        std::uint64_t generation() const;
+        
+    private:
+        std::shared_ptr<LibraryGeneration> m_generation;
+    };
+
+    using ReloadableWorkerPtr = std::unique_ptr<AbstractWorker, GenerationDeleter>;
+
+    // Loads successive builds of the library at a fixed path
+    // Every reload() copies the file to a private temporary path and opens the
+    // copy RTLD_LOCAL, so the dynamic loader treats it as a new library even
+    // if the path and inode are unchanged. The copy's own factories are used
+    // for new workers, while vague-linkage symbols (type_info, vtables, inline
+    // members) still resolve to the process-wide definitions first, so workers
+    // from every generation share RTTI with the host.
+    //
+    // Only factory code is reloaded: the C interface functions of the new
+    // build construct the workers, but their vtables, type_info and
+    // SharedWorker / TemplatedWorker members are those of the copy loaded
+    // first, so changes to member functions take effect only on restart. A
+    // build that changes the layout of the shared types would be undefined
+    // behaviour; reload() rejects one whose weak_symbol_layout_stamp_c()
+    // differs from the stamp the reloader was given (the host's by default).
+    //
+    // A generation is only unmapped by dlclose if nothing pins it: GCC's
+    // STB_GNU_UNIQUE symbols (avoided with WEAK_SYMBOL_NO_GNU_UNIQUE),
+    // DF_1_NODELETE, or thread_local destructors registered by its code
+    class LibraryReloader {
+    public:
+        explicit LibraryReloader(const std::string& libraryPath,
+                                 std::uint64_t layoutStamp = libraryLayoutStamp())
+            : m_libraryPath(libraryPath), m_layoutStamp(layoutStamp) {}
+        LibraryReloader(const LibraryReloader&) = delete;
+        LibraryReloader& operator=(const LibraryReloader&) = delete;
+        
+        // Load the build currently at the library path as the new generation
+        // On failure (including a layout stamp mismatch) the previous
+        // generation stays current
+        bool reload(std::string* error = nullptr);
+        
+        // Number of the current generation (1, 2, ...), 0 before the first reload
+        std::uint64_t generation() const;
+        
+        // Generations still loaded: the current one plus older ones with live workers
+        std::size_t loadedGenerations() const;
+        
+        // Private path the current generation was opened from (already unlinked)
+        std::string loadedPath() const;
+        
+        // Factories of the current generation; nullptr before the first reload
+        ReloadableWorkerPtr createSharedWorker(int value) const;
+        ReloadableWorkerPtr createTemplatedWorkerInt(int value) const;
+        ReloadableWorkerPtr createTemplatedWorkerString(const std::string& value) const;
+        
+    private:
+        std::shared_ptr<LibraryGeneration> current() const;
+        
+        std::string m_libraryPath;
+        std::uint64_t m_layoutStamp;
+        mutable std::mutex m_mutex;
+        std::shared_ptr<LibraryGeneration> m_current;
+        mutable std::vector<std::weak_ptr<LibraryGeneration>> m_generations;
+        std::uint64_t m_nextGeneration = 1;
+    };
+
+} // namespace WeakSymbolExample
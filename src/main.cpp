@@ -1,25 +1,28 @@
 #include "../include/base_types.h"
+#include "../include/object_ref.h"
 #include "../include/shared_class.h"
 #include "../lib/shared_library.h"
+#include "host_implementation.h"
+#include "library_reloader.h"
+#include "plugin_loader.h"
+#include "startup_profiler.h"
+#include <dlfcn.h>
 #include <gtest/gtest.h>
+#include <unistd.h>
 #include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <fstream>
+#include <limits>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <vector>
 #include <iomanip>
 #include <typeinfo>
 
-// Forward declarations for host-side functions (defined in host_implementation.cpp)
-namespace WeakSymbolExample {
-    std::unique_ptr<AbstractWorker> createHostSharedWorker(int value);
-    std::unique_ptr<IBaseObject> createHostBaseObject(int value);
-    std::unique_ptr<AbstractWorker> createHostTemplatedWorkerInt(int value);
-    std::unique_ptr<AbstractWorker> createHostTemplatedWorkerString(const std::string& value);
-    
-    bool testHostDynamicCast(IBaseObject* obj);
-    std::string getHostTypeInfo(IBaseObject* obj);
-    void printHostObjectInfo(IBaseObject* obj);
-}
-
 using namespace WeakSymbolExample;
 
 // Test basic object creation and method calls
@@ -166,7 +169,7 @@ TEST(WeakSymbolLinking, TemplateUnification) {
     
     // Test that template instances work correctly
     if (castedDLLInt) {
-        EXPECT_EQ(castedDLLInt->getValue(), static_cast<int>(reinterpret_cast<intptr_t>(&castedDLLInt->getData())));
+        EXPECT_EQ(castedDLLInt->getValue(), 2000);
     }
     if (castedHostString) {
         EXPECT_EQ(castedHostString->getData(), "HOST_STRING");
@@ -200,6 +203,1206 @@ TEST(WeakSymbolLinking, CInterface) {
     destroy_dll_object_c(cObj);
 }
 
+// Test batched C interface
+TEST(WeakSymbolLinking, BatchedCInterface) {
+    std::vector<int> values(1000);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<int>(i) - 10;
+    }
+    
+    std::vector<IBaseObject*> objects(values.size(), nullptr);
+    ASSERT_EQ(create_dll_objects_c(values.data(), values.size(), objects.data()), values.size());
+    
+    for (size_t i = 0; i < objects.size(); ++i) {
+        ASSERT_NE(objects[i], nullptr);
+        EXPECT_EQ(objects[i]->getValue(), values[i]);
+        SharedWorker* worker = dynamic_cast<SharedWorker*>(objects[i]);
+        ASSERT_NE(worker, nullptr);
+        EXPECT_EQ(worker->getSource(), "DLL-C-Interface");
+    }
+    
+    // Host-created objects and nulls can go through the bulk destroy too
+    objects.push_back(createHostBaseObject(1).release());
+    objects.push_back(nullptr);
+    destroy_dll_objects_c(objects.data(), objects.size());
+    
+    // Degenerate arguments
+    EXPECT_EQ(create_dll_objects_c(nullptr, 10, objects.data()), 0u);
+    EXPECT_EQ(create_dll_objects_c(values.data(), 0, objects.data()), 0u);
+    EXPECT_NO_THROW(destroy_dll_objects_c(nullptr, 10));
+}
+
+// Test pooled allocation from the DLL factories
+TEST(WeakSymbolLinking, PooledAllocation) {
+    trimObjectPool();
+    
+    auto pooled = createDLLSharedWorker(700, AllocationPolicy::Pooled);
+    ASSERT_NE(pooled, nullptr);
+    EXPECT_EQ(pooled->getValue(), 700);
+    EXPECT_NE(dynamic_cast<SharedWorker*>(pooled.get()), nullptr);
+    
+    // Pooled objects are the same type as heap objects
+    auto heap = createDLLSharedWorker(701);
+    const auto& pooled_ref = *pooled;
+    const auto& heap_ref = *heap;
+    EXPECT_EQ(typeid(pooled_ref), typeid(heap_ref));
+    
+    // Deleting on the host side returns the block to the DLL pool
+    const void* firstAddress = pooled.get();
+    const std::size_t cachedBefore = pooledObjectStatistics().cachedBlocks;
+    pooled.reset();
+    EXPECT_EQ(pooledObjectStatistics().cachedBlocks, cachedBefore + 1);
+    
+    // The next pooled object of the same size reuses that block
+    const std::size_t reusesBefore = pooledObjectStatistics().reuses;
+    auto reused = createDLLBaseObject(702, AllocationPolicy::Pooled);
+    EXPECT_EQ(static_cast<const void*>(reused.get()), firstAddress);
+    EXPECT_EQ(pooledObjectStatistics().reuses, reusesBefore + 1);
+}
+
+// Test pooled C interface objects destroyed on another thread
+TEST(WeakSymbolLinking, PooledCrossThreadDestroy) {
+    IBaseObject* cObj = create_dll_object_pooled_c(800);
+    ASSERT_NE(cObj, nullptr);
+    EXPECT_EQ(cObj->getValue(), 800);
+    EXPECT_EQ(test_dynamic_cast_c(cObj), 1);
+    
+    // The destroying thread caches the block in its own pool
+    std::size_t cachedOnWorker = 0;
+    std::thread destroyer([&]() {
+        destroy_dll_object_c(cObj);
+        cachedOnWorker = pooledObjectStatistics().cachedBlocks;
+    });
+    destroyer.join();
+    EXPECT_EQ(cachedOnWorker, 1u);
+}
+
+// Test that the cast cache agrees with dynamic_cast on both sides of the boundary
+TEST(WeakSymbolLinking, CachedCastMatchesDynamicCast) {
+    clearCastCache();
+    
+    std::vector<std::unique_ptr<IBaseObject>> objects;
+    objects.push_back(createHostSharedWorker(1));
+    objects.push_back(createDLLSharedWorker(2));
+    objects.push_back(createHostTemplatedWorkerInt(3));
+    objects.push_back(createDLLTemplatedWorkerInt(4));
+    objects.push_back(createHostTemplatedWorkerString("host"));
+    objects.push_back(createDLLTemplatedWorkerString("dll"));
+    objects.push_back(createDLLBaseObject(5, AllocationPolicy::Pooled));
+    
+    // First pass fills the cache, second pass is served from it
+    for (int pass = 0; pass < 2; ++pass) {
+        for (const auto& object : objects) {
+            IBaseObject* obj = object.get();
+            EXPECT_EQ(cachedCast<AbstractWorker>(obj), dynamic_cast<AbstractWorker*>(obj));
+            EXPECT_EQ(cachedCast<SharedWorker>(obj), dynamic_cast<SharedWorker*>(obj));
+            EXPECT_EQ(cachedCast<TemplatedWorker<int>>(obj), dynamic_cast<TemplatedWorker<int>*>(obj));
+            EXPECT_EQ(cachedCast<TemplatedWorker<std::string>>(obj),
+                      dynamic_cast<TemplatedWorker<std::string>*>(obj));
+        }
+    }
+    
+    EXPECT_EQ(cachedCast<SharedWorker>(nullptr), nullptr);
+}
+
+namespace {
+    // Worker type unknown to the DLL, registered on first use
+    class HostOnlyWorker : public AbstractWorker {
+    public:
+        std::string getTypeName() const override { return "HostOnlyWorker"; }
+        int getValue() const override { return 0; }
+        void performAction() override {}
+        void doWork() override {}
+    };
+    
+    // Objects written before describeTo existed, overriding getDescription only
+    class DescriptionOnlyObject : public IBaseObject {
+    public:
+        std::string getTypeName() const override { return "DescriptionOnlyObject"; }
+        std::string getDescription() const override { return "legacy object"; }
+        int getValue() const override { return 0; }
+        void performAction() override {}
+    };
+    
+    class DescriptionOnlyWorker : public HostOnlyWorker {
+    public:
+        std::string getDescription() const override { return "legacy worker"; }
+    };
+}
+
+// Test that host and DLL agree on compact type IDs
+TEST(WeakSymbolLinking, TypeIdRegistry) {
+    auto hostWorker = createHostSharedWorker(1);
+    auto dllWorker = createDLLSharedWorker(2);
+    auto hostInt = createHostTemplatedWorkerInt(3);
+    auto dllInt = createDLLTemplatedWorkerInt(4);
+    auto hostString = createHostTemplatedWorkerString("host");
+    auto dllString = createDLLTemplatedWorkerString("dll");
+    
+    EXPECT_EQ(typeId(hostWorker.get()), kSharedWorkerTypeId);
+    EXPECT_EQ(typeId(dllWorker.get()), kSharedWorkerTypeId);
+    EXPECT_EQ(typeId(hostInt.get()), kTemplatedWorkerIntTypeId);
+    EXPECT_EQ(typeId(dllInt.get()), kTemplatedWorkerIntTypeId);
+    EXPECT_EQ(typeId(hostString.get()), kTemplatedWorkerStringTypeId);
+    EXPECT_EQ(typeId(dllString.get()), kTemplatedWorkerStringTypeId);
+    EXPECT_EQ(typeId(nullptr), kInvalidTypeId);
+    
+    EXPECT_STREQ(typeIdName(kSharedWorkerTypeId), typeid(SharedWorker).name());
+    EXPECT_EQ(typeIdName(kInvalidTypeId), nullptr);
+    
+    // Types the DLL has never seen get stable dynamic IDs
+    HostOnlyWorker local;
+    const TypeId localId = typeId(&local);
+    EXPECT_GE(localId, static_cast<TypeId>(kFirstDynamicTypeId));
+    EXPECT_EQ(typeId(&local), localId);
+    EXPECT_EQ(registerTypeId(typeid(HostOnlyWorker).name()), localId);
+    EXPECT_STREQ(typeIdName(localId), typeid(HostOnlyWorker).name());
+    
+    // The type_info cache agrees with the registry from every thread
+    EXPECT_EQ(typeIdOf(typeid(HostOnlyWorker)), localId);
+    std::vector<TypeId> seen(4, kInvalidTypeId);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < seen.size(); ++i) {
+        threads.emplace_back([&seen, &local, i] {
+            seen[i] = typeId(&local);
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    for (TypeId id : seen) {
+        EXPECT_EQ(id, localId);
+    }
+}
+
+// Test allocation-free descriptions against the string-returning wrapper
+TEST(WeakSymbolLinking, DescribeToBuffer) {
+    auto hostWorker = createHostSharedWorker(42);
+    auto dllWorker = createDLLSharedWorker(-7);
+    auto dllInt = createDLLTemplatedWorkerInt(123);
+    auto hostString = createHostTemplatedWorkerString("payload");
+    
+    EXPECT_EQ(hostWorker->getDescription(), "SharedWorker created from HOST with value 42");
+    EXPECT_EQ(dllWorker->getDescription(), "SharedWorker created from DLL with value -7");
+    EXPECT_EQ(dllInt->getDescription(), "TemplatedWorker from DLL with data: 123");
+    EXPECT_EQ(hostString->getDescription(), "TemplatedWorker from HOST with data: payload");
+    
+    for (AbstractWorker* worker : {hostWorker.get(), dllWorker.get(), dllInt.get(), hostString.get()}) {
+        char buffer[128];
+        const std::size_t length = worker->describeTo(buffer, sizeof(buffer));
+        EXPECT_EQ(std::string(buffer), worker->getDescription());
+        EXPECT_EQ(length, worker->getDescription().size());
+    }
+    
+    // Truncated output is terminated and still reports the full length
+    char small[8];
+    EXPECT_EQ(hostWorker->describeTo(small, sizeof(small)), hostWorker->getDescription().size());
+    EXPECT_STREQ(small, "SharedW");
+    EXPECT_EQ(hostWorker->describeTo(nullptr, 0), hostWorker->getDescription().size());
+    
+    // Descriptions longer than the wrapper's stack buffer
+    auto longString = createDLLTemplatedWorkerString(std::string(300, 'x'));
+    EXPECT_EQ(longString->getDescription(), "TemplatedWorker from DLL with data: " + std::string(300, 'x'));
+    
+    // Subclasses overriding only getDescription, or neither method
+    DescriptionOnlyObject legacyObject;
+    DescriptionOnlyWorker legacyWorker;
+    HostOnlyWorker plainWorker;
+    char buffer[64];
+    EXPECT_EQ(legacyObject.describeTo(buffer, sizeof(buffer)), 13u);
+    EXPECT_STREQ(buffer, "legacy object");
+    EXPECT_EQ(legacyWorker.describeTo(buffer, sizeof(buffer)), 13u);
+    EXPECT_STREQ(buffer, "legacy worker");
+    plainWorker.describeTo(buffer, sizeof(buffer));
+    EXPECT_STREQ(buffer, "AbstractWorker base implementation");
+    EXPECT_EQ(plainWorker.getDescription(), "AbstractWorker base implementation");
+}
+
+// Test the generic templated-worker factory and its C entry points
+TEST(WeakSymbolLinking, TypedTemplatedWorkerFactory) {
+    const std::int64_t big = std::int64_t(1) << 40;
+    auto int64Worker = createDLLTemplatedWorker(big);
+    auto doubleWorker = createDLLTemplatedWorker(2.5);
+    auto floatWorker = createDLLTemplatedWorker(0.5f);
+    auto float4Worker = createDLLTemplatedWorker(Float4{{1.0f, 2.0f, 3.0f, 4.5f}});
+    auto double4Worker = createDLLTemplatedWorker(Double4{{-1.0, 0.0, 1.0, 2.0}});
+    
+    // Payloads are stored unboxed and cast like any other worker
+    ASSERT_NE(cachedCast<TemplatedWorker<std::int64_t>>(int64Worker.get()), nullptr);
+    EXPECT_EQ(cachedCast<TemplatedWorker<std::int64_t>>(int64Worker.get())->getData(), big);
+    EXPECT_EQ(dynamic_cast<TemplatedWorker<double>*>(doubleWorker.get())->getData(), 2.5);
+    EXPECT_EQ(dynamic_cast<TemplatedWorker<float>*>(floatWorker.get())->getData(), 0.5f);
+    EXPECT_EQ(dynamic_cast<TemplatedWorker<Double4>*>(double4Worker.get())->getData(),
+              (Double4{{-1.0, 0.0, 1.0, 2.0}}));
+    EXPECT_EQ(dynamic_cast<TemplatedWorker<float>*>(doubleWorker.get()), nullptr);
+    
+    EXPECT_EQ(int64Worker->getDescription(), "TemplatedWorker from DLL with data: 1099511627776");
+    EXPECT_EQ(float4Worker->getDescription(), "TemplatedWorker from DLL with data: (1, 2, 3, 4.5)");
+    
+    // Host-created instances share type_info and type IDs with the DLL's
+    TemplatedWorker<Float4> hostFloat4(Float4{{0, 0, 0, 0}}, "HOST");
+    EXPECT_EQ(&typeid(hostFloat4), &typeid(*float4Worker));
+    EXPECT_EQ(typeId(&hostFloat4), typeId(float4Worker.get()));
+    EXPECT_NE(typeId(float4Worker.get()), typeId(double4Worker.get()));
+    
+    // C entry points
+    const float values[4] = {4.0f, 3.0f, 2.0f, 1.0f};
+    IBaseObject* fromC = create_dll_templated_worker_float4_c(values);
+    ASSERT_NE(fromC, nullptr);
+    EXPECT_EQ(cachedCast<TemplatedWorker<Float4>>(fromC)->getData(), (Float4{{4.0f, 3.0f, 2.0f, 1.0f}}));
+    EXPECT_EQ(cachedCast<TemplatedWorker<Float4>>(fromC)->getSource(), "DLL-C-Interface");
+    destroy_dll_object_c(fromC);
+    EXPECT_EQ(create_dll_templated_worker_double4_c(nullptr), nullptr);
+    
+    IBaseObject* int64FromC = create_dll_templated_worker_int64_c(-big);
+    EXPECT_EQ(cachedCast<TemplatedWorker<std::int64_t>>(int64FromC)->getData(), -big);
+    destroy_dll_object_c(int64FromC);
+}
+
+// Test value extraction from templated payloads
+TEST(WeakSymbolLinking, TemplatedWorkerValues) {
+    const std::int64_t big = std::int64_t(1) << 40;
+    EXPECT_EQ(createDLLTemplatedWorker(-17)->getValue(), -17);
+    EXPECT_EQ(createDLLTemplatedWorker(2.75)->getValue(), 2);
+    EXPECT_EQ(createDLLTemplatedWorker(-2.75f)->getValue(), -2);
+    
+    // Out-of-range values saturate; NaN and non-arithmetic payloads give 0
+    EXPECT_EQ(createDLLTemplatedWorker(big)->getValue(), INT_MAX);
+    EXPECT_EQ(createDLLTemplatedWorker(-big)->getValue(), INT_MIN);
+    EXPECT_EQ(createDLLTemplatedWorker(1e300)->getValue(), INT_MAX);
+    EXPECT_EQ(createDLLTemplatedWorker(std::numeric_limits<double>::quiet_NaN())->getValue(), 0);
+    EXPECT_EQ(createDLLTemplatedWorkerString("123")->getValue(), 0);
+    EXPECT_EQ(createDLLTemplatedWorker(Float4{{1, 2, 3, 4}})->getValue(), 0);
+    EXPECT_EQ(TemplatedWorker<unsigned>(4000000000u, "HOST").getValue(), INT_MAX);
+}
+
+// Test batched getValue over homogeneous and mixed objects
+TEST(WeakSymbolLinking, BulkGetValues) {
+    // Host- and DLL-created SharedWorkers share one vtable: direct path
+    std::vector<WorkerPtr> shared;
+    for (int i = 0; i < 6; ++i) {
+        shared.push_back(i % 2 ? createHostSharedWorker(i) : createDLLSharedWorker(i));
+    }
+    std::vector<IBaseObject*> objects;
+    for (const WorkerPtr& worker : shared) objects.push_back(worker.get());
+    objects.insert(objects.begin() + 2, nullptr);
+    
+    std::vector<int> values(objects.size(), -1);
+    getValues(objects.data(), objects.size(), values.data());
+    EXPECT_EQ(values, (std::vector<int>{0, 1, 0, 2, 3, 4, 5}));
+    
+    // Mixed concrete types go through virtual dispatch
+    auto doubleWorker = createDLLTemplatedWorker(9.5);
+    auto stringWorker = createHostTemplatedWorkerString("text");
+    objects.push_back(doubleWorker.get());
+    objects.push_back(stringWorker.get());
+    values.assign(objects.size(), -1);
+    getValues(objects.data(), objects.size(), values.data());
+    EXPECT_EQ(values, (std::vector<int>{0, 1, 0, 2, 3, 4, 5, 9, 0}));
+    
+    // Types unknown to the DLL also fall back to virtual dispatch
+    TemplatedWorker<unsigned> hostOnly(7u, "HOST");
+    IBaseObject* single[] = {&hostOnly};
+    int value = -1;
+    getValues(single, 1, &value);
+    EXPECT_EQ(value, 7);
+    
+    getValues(nullptr, 0, nullptr);
+}
+
+namespace {
+    // Sink recording everything written by workers
+    class CapturingSink : public WorkerOutputSink {
+    public:
+        void write(const char* data, std::size_t length) override {
+            text.append(data, length);
+            ++writes;
+        }
+        
+        std::string text;
+        int writes = 0;
+    };
+    
+    // Restores default output routing when a test ends
+    struct OutputRestorer {
+        ~OutputRestorer() {
+            setWorkerOutputMode(WorkerOutputMode::Immediate);
+            setWorkerOutputSink(nullptr);
+        }
+    };
+}
+
+// Test the pluggable worker output modes
+TEST(WeakSymbolLinking, WorkerOutputModes) {
+    OutputRestorer restorer;
+    CapturingSink sink;
+    setWorkerOutputSink(&sink);
+    
+    auto hostWorker = createHostSharedWorker(5);
+    auto dllWorker = createDLLTemplatedWorkerInt(6);
+    EXPECT_EQ(sink.text, "DLL: Creating TemplatedWorker<int> with value 6\n");
+    
+    // Immediate: each line reaches the sink right away
+    sink.text.clear();
+    setWorkerOutputMode(WorkerOutputMode::Immediate);
+    hostWorker->performAction();
+    EXPECT_EQ(sink.text, "SharedWorker::performAction() called from HOST with value 5\n");
+    
+    // Buffered: nothing arrives until the thread's buffer is flushed
+    sink.text.clear();
+    sink.writes = 0;
+    setWorkerOutputMode(WorkerOutputMode::Buffered);
+    hostWorker->doWork();
+    dllWorker->doWork();
+    dllWorker->performAction();
+    EXPECT_TRUE(sink.text.empty());
+    flushWorkerOutput();
+    EXPECT_EQ(sink.text,
+              "SharedWorker::doWork() - Processing work from HOST\n"
+              "TemplatedWorker::doWork() with data: 6\n"
+              "TemplatedWorker::performAction() from DLL\n");
+    EXPECT_EQ(sink.writes, 1);
+    
+    // Buffered lines from another thread are written when it exits
+    sink.text.clear();
+    std::thread worker([&]() { hostWorker->performAction(); });
+    worker.join();
+    EXPECT_EQ(sink.text, "SharedWorker::performAction() called from HOST with value 5\n");
+    
+    // Discard: factories and workers produce nothing
+    sink.text.clear();
+    setWorkerOutputMode(WorkerOutputMode::Discard);
+    auto quiet = createDLLSharedWorker(7);
+    quiet->performAction();
+    quiet->doWork();
+    flushWorkerOutput();
+    EXPECT_TRUE(sink.text.empty());
+}
+
+// Test type-grouped batch calls over a mixed host/DLL array
+TEST(WeakSymbolLinking, GroupedBatchDispatch) {
+    OutputRestorer restorer;
+    CapturingSink sink;
+    setWorkerOutputSink(&sink);
+    setWorkerOutputMode(WorkerOutputMode::Discard);
+    
+    auto hostShared = createHostSharedWorker(3);
+    auto dllDouble = createDLLTemplatedWorker(1.5);
+    auto dllShared = createDLLSharedWorker(0);
+    auto hostString = createHostTemplatedWorkerString("text");
+    auto dllDoubleToo = createDLLTemplatedWorker(-2.0);
+    TemplatedWorker<unsigned> hostOnly(9u, "HOST");
+    
+    IBaseObject* objects[] = {
+        hostShared.get(), dllDouble.get(), nullptr, dllShared.get(),
+        hostString.get(), &hostOnly, dllDoubleToo.get()
+    };
+    const std::size_t count = sizeof(objects) / sizeof(objects[0]);
+    
+    // Results land at the caller's positions whatever the grouping
+    std::vector<int> values(count, -1);
+    getValues(objects, count, values.data());
+    EXPECT_EQ(values, (std::vector<int>{3, 1, 0, 0, 0, 9, -2}));
+    
+    bool flags[count];
+    getReadyFlags(objects, count, flags);
+    const bool expectedFlags[count] = {true, true, false, false, true, true, true};
+    for (std::size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(flags[i], expectedFlags[i]) << "index " << i;
+    }
+    
+    // Types run in order of first appearance, input order within a type
+    setWorkerOutputMode(WorkerOutputMode::Immediate);
+    performActions(objects, count);
+    EXPECT_EQ(sink.text,
+              "SharedWorker::performAction() called from HOST with value 3\n"
+              "SharedWorker::performAction() called from DLL with value 0\n"
+              "TemplatedWorker::performAction() from DLL\n"
+              "TemplatedWorker::performAction() from DLL\n"
+              "TemplatedWorker::performAction() from HOST\n"
+              "TemplatedWorker::performAction() from HOST\n");
+    
+    // More types than a chunk has typed groups, over several chunks
+    TemplatedWorker<char> charWorker('a', "HOST");
+    TemplatedWorker<short> shortWorker(2, "HOST");
+    TemplatedWorker<long> longWorker(3, "HOST");
+    TemplatedWorker<long long> longLongWorker(4, "HOST");
+    TemplatedWorker<unsigned short> ushortWorker(5, "HOST");
+    TemplatedWorker<unsigned long> ulongWorker(6, "HOST");
+    TemplatedWorker<float> floatWorker(7.0f, "HOST");
+    std::vector<IBaseObject*> many;
+    for (std::size_t i = 0; i < 600; ++i) {
+        IBaseObject* const kinds[] = {
+            hostShared.get(), dllDouble.get(), nullptr, dllShared.get(), hostString.get(),
+            &hostOnly, &charWorker, &shortWorker, &longWorker, &longLongWorker,
+            &ushortWorker, &ulongWorker, &floatWorker
+        };
+        many.push_back(kinds[i % (sizeof(kinds) / sizeof(kinds[0]))]);
+    }
+    std::unique_ptr<bool[]> manyFlags(new bool[many.size()]);
+    getReadyFlags(many.data(), many.size(), manyFlags.get());
+    std::size_t actions = 0;
+    for (std::size_t i = 0; i < many.size(); ++i) {
+        EXPECT_EQ(manyFlags[i], many[i] != nullptr && many[i] != dllShared.get()) << "index " << i;
+        if (many[i]) ++actions;
+    }
+    sink.text.clear();
+    performActions(many.data(), many.size());
+    EXPECT_EQ(static_cast<std::size_t>(std::count(sink.text.begin(), sink.text.end(), '\n')), actions);
+    
+    getReadyFlags(nullptr, 0, nullptr);
+    performActions(nullptr, 0);
+}
+
+// Test intrusive shared ownership across the boundary
+TEST(WeakSymbolLinking, ObjectRefSharedOwnership) {
+    // A DLL object shared by the host goes back to the DLL's pool on last release
+    ObjectRef<AbstractWorker> worker(createDLLSharedWorker(5, AllocationPolicy::Pooled));
+    const std::size_t cachedBefore = pooledObjectStatistics().cachedBlocks;
+    EXPECT_EQ(worker.useCount(), 1u);
+    {
+        ObjectRef<AbstractWorker> copy = worker;
+        ObjectRef<IBaseObject> base = copy;
+        EXPECT_EQ(worker.useCount(), 3u);
+        EXPECT_TRUE(base == worker);
+        
+        auto shared = dynamicRefCast<SharedWorker>(base);
+        ASSERT_TRUE(shared);
+        EXPECT_EQ(shared->getValue(), 5);
+        EXPECT_FALSE(dynamicRefCast<TemplatedWorker<int>>(base));
+    }
+    EXPECT_EQ(worker.useCount(), 1u);
+    
+    // References taken and dropped concurrently
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([worker]() {
+            for (int i = 0; i < 1000; ++i) {
+                ObjectRef<IBaseObject> local = worker;
+                EXPECT_EQ(local->getValue(), 5);
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    EXPECT_EQ(worker.useCount(), 1u);
+    
+    worker.reset();
+    EXPECT_EQ(pooledObjectStatistics().cachedBlocks, cachedBefore + 1);
+    
+    // Copying an object does not copy its count
+    auto hostWorker = makeObjectRef<SharedWorker>(7, "HOST");
+    SharedWorker copy(*hostWorker);
+    EXPECT_EQ(hostWorker.useCount(), 1u);
+    EXPECT_EQ(copy.refCount(), 1u);
+    
+    // Sharing an object a unique_ptr still owns leaves that ownership intact
+    auto owned = createDLLSharedWorker(8);
+    {
+        auto borrowed = ObjectRef<AbstractWorker>::share(owned.get());
+        EXPECT_EQ(borrowed.useCount(), 2u);
+    }
+    EXPECT_EQ(owned->refCount(), 1u);
+    EXPECT_EQ(owned->getValue(), 8);
+    
+    // C interface: the creator holds one reference and the last release
+    // destroys the object in the DLL
+    IBaseObject* cObject = create_dll_object_pooled_c(9);
+    EXPECT_EQ(cObject->refCount(), 1u);
+    auto fromC = ObjectRef<IBaseObject>::share(cObject);
+    EXPECT_EQ(fromC.useCount(), 2u);
+    release_dll_object_c(cObject);
+    EXPECT_EQ(fromC.useCount(), 1u);
+    const std::size_t cachedBeforeC = pooledObjectStatistics().cachedBlocks;
+    fromC.reset();
+    EXPECT_EQ(pooledObjectStatistics().cachedBlocks, cachedBeforeC + 1);
+    
+    // create then release alone destroys the object
+    IBaseObject* cOnly = create_dll_object_pooled_c(10);
+    retain_dll_object_c(cOnly);
+    release_dll_object_c(cOnly);
+    EXPECT_EQ(cOnly->refCount(), 1u);
+    const std::size_t cachedBeforeRelease = pooledObjectStatistics().cachedBlocks;
+    release_dll_object_c(cOnly);
+    EXPECT_EQ(pooledObjectStatistics().cachedBlocks, cachedBeforeRelease + 1);
+    
+    // adopt takes over the creator reference
+    auto adopted = ObjectRef<IBaseObject>::adopt(create_dll_object_pooled_c(11));
+    EXPECT_EQ(adopted.useCount(), 1u);
+    
+    retain_dll_object_c(nullptr);
+    release_dll_object_c(nullptr);
+}
+
+namespace {
+    // SharedWorker whose destruction is observable
+    class CountedWorker : public SharedWorker {
+    public:
+        explicit CountedWorker(int value) : SharedWorker(value, "HOST") {}
+        ~CountedWorker() override { ++destroyed; }
+        static int destroyed;
+    };
+    
+    int CountedWorker::destroyed = 0;
+}
+
+// Test request-lifetime worker arenas
+TEST(WeakSymbolLinking, WorkerArenaLifetime) {
+    OutputRestorer restorer;
+    setWorkerOutputMode(WorkerOutputMode::Discard);
+    
+    WorkerArena arena(1024);
+    std::vector<AbstractWorker*> workers;
+    for (int i = 0; i < 300; ++i) {
+        switch (i % 3) {
+            case 0: workers.push_back(createDLLSharedWorker(i, arena)); break;
+            case 1: workers.push_back(createDLLTemplatedWorker(static_cast<double>(i), arena)); break;
+            default: workers.push_back(createDLLTemplatedWorker(std::to_string(i), arena)); break;
+        }
+    }
+    EXPECT_EQ(arena.objectCount(), 300u);
+    EXPECT_GT(arena.bytesReserved(), 1024u);
+    
+    // Arena workers behave like any other DLL worker
+    EXPECT_EQ(workers[3]->getValue(), 3);
+    EXPECT_EQ(workers[4]->getValue(), 4);
+    EXPECT_TRUE(dynamic_cast<SharedWorker*>(workers[0]) != nullptr);
+    EXPECT_TRUE(dynamic_cast<TemplatedWorker<std::string>*>(workers[2]) != nullptr);
+    EXPECT_EQ(typeid(*workers[0]), typeid(SharedWorker));
+    
+    // Types with real destructors run them at reset, newest first
+    CountedWorker::destroyed = 0;
+    arena.create<CountedWorker>(1);
+    arena.create<CountedWorker>(2);
+    arena.reset();
+    EXPECT_EQ(CountedWorker::destroyed, 2);
+    EXPECT_EQ(arena.objectCount(), 0u);
+    EXPECT_EQ(arena.bytesUsed(), 0u);
+    
+    // Chunks are kept and reused by the next batch
+    const std::size_t reserved = arena.bytesReserved();
+    for (int i = 0; i < 300; ++i) {
+        createDLLSharedWorker(i, arena);
+    }
+    EXPECT_EQ(arena.bytesReserved(), reserved);
+    
+    // Objects larger than a chunk get a chunk of their own
+    WorkerArena tiny(16);
+    AbstractWorker* big = createDLLTemplatedWorker(Double4{{1, 2, 3, 4}}, tiny);
+    EXPECT_EQ(dynamic_cast<TemplatedWorker<Double4>*>(big)->getData(), (Double4{{1, 2, 3, 4}}));
+    
+    CountedWorker::destroyed = 0;
+    {
+        WorkerArena scoped;
+        scoped.create<CountedWorker>(3);
+    }
+    EXPECT_EQ(CountedWorker::destroyed, 1);
+}
+
+// Test the lock-free queue on one thread
+TEST(WeakSymbolLinking, WorkerQueueBasics) {
+    WorkerQueue queue(5);
+    EXPECT_EQ(queue.capacity(), 8u);
+    EXPECT_EQ(queue.tryPop(), nullptr);
+    EXPECT_FALSE(queue.tryPush(nullptr));
+    
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(queue.tryPush(new SharedWorker(i, "HOST")));
+    }
+    
+    // A failed push leaves ownership with the caller
+    WorkerPtr extra = createHostSharedWorker(8);
+    EXPECT_FALSE(queue.tryPush(extra));
+    ASSERT_TRUE(extra);
+    EXPECT_EQ(queue.sizeApprox(), 8u);
+    
+    for (int i = 0; i < 8; ++i) {
+        BaseObjectPtr obj = queue.tryPopObject();
+        ASSERT_TRUE(obj);
+        EXPECT_EQ(obj->getValue(), i);
+    }
+    EXPECT_FALSE(queue.tryPopObject());
+    
+    EXPECT_TRUE(queue.tryPush(extra));
+    EXPECT_FALSE(extra);
+    
+    // Objects still queued are deleted with the queue
+    CountedWorker::destroyed = 0;
+    {
+        WorkerQueue leftovers(2);
+        leftovers.tryPush(new CountedWorker(1));
+    }
+    EXPECT_EQ(CountedWorker::destroyed, 1);
+}
+
+// Test handing workers between threads: objects created by the DLL are
+// destroyed by the host and vice versa
+TEST(WeakSymbolLinking, WorkerQueueCrossThreadHandoff) {
+    OutputRestorer restorer;
+    setWorkerOutputMode(WorkerOutputMode::Discard);
+    
+    constexpr int kPerProducer = 5000;
+    WorkerQueue queue(64);
+    std::atomic<int> consumed(0);
+    std::atomic<long long> valueSum(0);
+    
+    auto produce = [&](bool fromDll) {
+        for (int i = 1; i <= kPerProducer; ++i) {
+            WorkerPtr worker = fromDll ? createDLLSharedWorker(i, AllocationPolicy::Pooled)
+                                       : createHostSharedWorker(i);
+            while (!queue.tryPush(worker)) std::this_thread::yield();
+        }
+    };
+    
+    // One consumer deletes in the host, the other through the DLL's C interface
+    auto consume = [&](bool inDll) {
+        while (consumed.load() < 2 * kPerProducer) {
+            IBaseObject* obj = queue.tryPop();
+            if (!obj) {
+                std::this_thread::yield();
+                continue;
+            }
+            valueSum += obj->getValue();
+            if (inDll) {
+                destroy_dll_object_c(obj);
+            } else {
+                delete obj;
+            }
+            ++consumed;
+        }
+    };
+    
+    std::vector<std::thread> threads;
+    threads.emplace_back(produce, true);
+    threads.emplace_back(produce, false);
+    threads.emplace_back(consume, true);
+    threads.emplace_back(consume, false);
+    for (std::thread& thread : threads) thread.join();
+    
+    EXPECT_EQ(consumed.load(), 2 * kPerProducer);
+    EXPECT_EQ(valueSum.load(), 2LL * kPerProducer * (kPerProducer + 1) / 2);
+    EXPECT_EQ(queue.tryPop(), nullptr);
+}
+
+#ifdef WEAK_SYMBOL_ENABLE_COROUTINES
+namespace {
+    // Worker that records its steps and yields to the loop between them
+    class SteppingWorker : public SharedWorker {
+    public:
+        SteppingWorker(int value, std::string& trace, int steps)
+            : SharedWorker(value, "HOST"), m_trace(trace), m_steps(steps) {}
+        
+        WorkerTask doWorkAsync() override {
+            for (int step = 1; step <= m_steps; ++step) {
+                m_trace += std::to_string(getValue()) + "." + std::to_string(step) + " ";
+                co_await EventLoop::yield();
+            }
+        }
+        
+    private:
+        std::string& m_trace;
+        int m_steps;
+    };
+    
+    WorkerTask failingTask() {
+        co_await EventLoop::yield();
+        throw std::runtime_error("async failure");
+    }
+    
+    WorkerTask awaitingTask(AbstractWorker& worker, int& finished) {
+        co_await worker.doWorkAsync();
+        ++finished;
+    }
+}
+
+// Test coroutine workers interleaving on the event loop
+TEST(WeakSymbolLinking, EventLoopInterleavesWorkers) {
+    std::string trace;
+    SteppingWorker first(1, trace, 2), second(2, trace, 2), third(3, trace, 1);
+    
+    EventLoop loop;
+    loop.spawn(first);
+    loop.spawn(second);
+    loop.spawn(third);
+    EXPECT_EQ(loop.pendingTasks(), 3u);
+    EXPECT_EQ(loop.run(), 3u);
+    EXPECT_EQ(trace, "1.1 2.1 3.1 1.2 2.2 ");
+    EXPECT_EQ(loop.pendingTasks(), 0u);
+    EXPECT_EQ(EventLoop::current(), nullptr);
+    
+    // Thousands of workers on one thread
+    std::string bulkTrace;
+    std::vector<std::unique_ptr<SteppingWorker>> workers;
+    for (int i = 0; i < 5000; ++i) {
+        workers.push_back(std::make_unique<SteppingWorker>(i, bulkTrace, 3));
+        loop.spawn(*workers.back());
+    }
+    EXPECT_EQ(loop.run(), 5000u);
+    EXPECT_EQ(std::count(bulkTrace.begin(), bulkTrace.end(), ' '), 15000);
+}
+
+// Test the default doWorkAsync of host and DLL workers, awaiting and errors
+TEST(WeakSymbolLinking, EventLoopDefaultsAndErrors) {
+    OutputRestorer restorer;
+    CapturingSink sink;
+    setWorkerOutputSink(&sink);
+    setWorkerOutputMode(WorkerOutputMode::Discard);
+    auto dllWorker = createDLLSharedWorker(4);
+    auto templatedWorker = createDLLTemplatedWorkerInt(5);
+    setWorkerOutputMode(WorkerOutputMode::Immediate);
+    
+    // Default implementations run doWork(); tasks can await other tasks
+    EventLoop loop;
+    int finished = 0;
+    loop.spawn(awaitingTask(*dllWorker, finished));
+    loop.spawn(*templatedWorker);
+    EXPECT_EQ(loop.run(), 2u);
+    EXPECT_EQ(finished, 1);
+    EXPECT_EQ(sink.text,
+              "SharedWorker::doWork() - Processing work from DLL\n"
+              "TemplatedWorker::doWork() with data: 5\n");
+    
+    // A failing task does not stop the others; run() rethrows afterwards
+    std::string trace;
+    SteppingWorker stepping(7, trace, 3);
+    loop.spawn(failingTask());
+    loop.spawn(stepping);
+    EXPECT_THROW(loop.run(), std::runtime_error);
+    EXPECT_EQ(trace, "7.1 7.2 7.3 ");
+    
+    // Tasks a loop never ran are destroyed with it
+    finished = 0;
+    {
+        EventLoop unused;
+        unused.spawn(awaitingTask(stepping, finished));
+        EXPECT_EQ(unused.pendingTasks(), 1u);
+    }
+    EXPECT_EQ(finished, 0);
+}
+#endif
+
+// Test the log-linear latency bucket layout
+TEST(WeakSymbolLinking, LatencyBucketLayout) {
+    using namespace LatencyBuckets;
+    
+    // Exact buckets below 32 ns, then 32 sub-buckets per power of two
+    EXPECT_EQ(indexOf(0), 0u);
+    EXPECT_EQ(indexOf(31), 31u);
+    EXPECT_EQ(indexOf(32), 32u);
+    EXPECT_EQ(indexOf(64), 64u);
+    EXPECT_EQ(indexOf(UINT64_MAX), kCount - 1);
+    
+    // Every value lies in its bucket, within ~3% of the bucket's bound
+    for (std::uint64_t ns : {1ull, 33ull, 100ull, 1000ull, 12345ull, 999999ull, 123456789ull}) {
+        const std::size_t index = indexOf(ns);
+        EXPECT_LE(ns, upperBound(index));
+        EXPECT_GT(ns, index ? upperBound(index - 1) : 0);
+        EXPECT_LE(static_cast<double>(upperBound(index) - ns), 0.032 * static_cast<double>(ns));
+    }
+    
+    LatencySnapshot snapshot = {"test", 0, 0, UINT64_MAX, 0, std::vector<std::uint64_t>(kCount, 0)};
+    EXPECT_EQ(snapshot.percentileNs(0.99), 0u);
+    for (std::uint64_t ns = 1; ns <= 1000; ++ns) {
+        ++snapshot.buckets[indexOf(ns)];
+        ++snapshot.count;
+        snapshot.totalNs += ns;
+    }
+    snapshot.minNs = 1;
+    snapshot.maxNs = 1000;
+    EXPECT_NEAR(static_cast<double>(snapshot.percentileNs(0.5)), 500.0, 16.0);
+    EXPECT_NEAR(static_cast<double>(snapshot.percentileNs(0.99)), 990.0, 32.0);
+    EXPECT_EQ(snapshot.percentileNs(1.0), 1000u);
+    EXPECT_DOUBLE_EQ(snapshot.meanNs(), 500.5);
+}
+
+// Test per-call latency recording of the library entry points
+TEST(WeakSymbolLinking, LatencyHistogramsRecordEntryPoints) {
+    if (!latencyHistogramsEnabled()) {
+        EXPECT_TRUE(latencySnapshot().empty());
+        EXPECT_NE(formatLatencyReport().find("disabled"), std::string::npos);
+        return;
+    }
+    
+    OutputRestorer restorer;
+    setWorkerOutputMode(WorkerOutputMode::Discard);
+    resetLatencyHistograms();
+    
+    for (int i = 0; i < 100; ++i) {
+        auto worker = createDLLSharedWorker(i);
+        destroy_dll_object_c(create_dll_object_c(i));
+    }
+    auto doubleWorker = createDLLTemplatedWorker(2.5);
+    auto intWorker = createDLLTemplatedWorkerInt(3);
+    EXPECT_EQ(test_dynamic_cast_c(intWorker.get()), 1);
+    
+    // Calls on threads that have exited are kept
+    std::thread caller([]() {
+        for (int i = 0; i < 50; ++i) {
+            destroy_dll_object_c(create_dll_object_c(i));
+        }
+    });
+    caller.join();
+    
+    auto find = [](const std::vector<LatencySnapshot>& snapshots, const std::string& name) {
+        for (const LatencySnapshot& snapshot : snapshots) {
+            if (snapshot.name == name) return snapshot.count;
+        }
+        return std::uint64_t(0);
+    };
+    
+    const std::vector<LatencySnapshot> snapshots = latencySnapshot();
+    EXPECT_EQ(find(snapshots, "createDLLSharedWorker"), 100u);
+    EXPECT_EQ(find(snapshots, "create_dll_object_c"), 150u);
+    EXPECT_EQ(find(snapshots, "destroy_dll_object_c"), 150u);
+    EXPECT_EQ(find(snapshots, "createDLLTemplatedWorker<double>"), 1u);
+    
+    // Entry points that delegate are recorded once, under the caller's name
+    EXPECT_EQ(find(snapshots, "createDLLTemplatedWorkerInt"), 1u);
+    EXPECT_EQ(find(snapshots, "createDLLTemplatedWorker<int>"), 0u);
+    EXPECT_EQ(find(snapshots, "test_dynamic_cast_c"), 1u);
+    EXPECT_EQ(find(snapshots, "testDynamicCast"), 0u);
+    
+    for (const LatencySnapshot& snapshot : snapshots) {
+        EXPECT_LE(snapshot.minNs, snapshot.percentileNs(0.5)) << snapshot.name;
+        EXPECT_LE(snapshot.percentileNs(0.5), snapshot.percentileNs(0.99)) << snapshot.name;
+        EXPECT_LE(snapshot.percentileNs(0.999), snapshot.maxNs) << snapshot.name;
+    }
+    EXPECT_NE(formatLatencyReport().find("create_dll_object_c"), std::string::npos);
+    
+    resetLatencyHistograms();
+    EXPECT_EQ(find(latencySnapshot(), "create_dll_object_c"), 0u);
+    
+    // The owning thread clears its stale counts on its next record
+    destroy_dll_object_c(create_dll_object_c(0));
+    EXPECT_EQ(find(latencySnapshot(), "create_dll_object_c"), 1u);
+    
+    // Resets racing a recording thread never leave counts without buckets
+    std::atomic<bool> stop(false);
+    std::thread recorder([&stop]() {
+        while (!stop.load(std::memory_order_relaxed)) {
+            destroy_dll_object_c(create_dll_object_c(0));
+        }
+    });
+    for (int i = 0; i < 200; ++i) {
+        resetLatencyHistograms();
+        for (const LatencySnapshot& snapshot : latencySnapshot()) {
+            std::uint64_t bucketed = 0;
+            for (std::uint64_t bucket : snapshot.buckets) bucketed += bucket;
+            EXPECT_EQ(snapshot.count, bucketed) << snapshot.name;
+        }
+    }
+    stop.store(true);
+    recorder.join();
+}
+
+namespace {
+    // Worker whose doWork always fails
+    class ThrowingWorker : public AbstractWorker {
+    public:
+        std::string getTypeName() const override { return "ThrowingWorker"; }
+        int getValue() const override { return 0; }
+        void performAction() override {}
+        void doWork() override { throw std::runtime_error("doWork failed"); }
+    };
+}
+
+// Test running mixed host/DLL workers on the executor
+TEST(WeakSymbolLinking, WorkerExecutorRunsBatch) {
+    OutputRestorer restorer;
+    setWorkerOutputMode(WorkerOutputMode::Discard);
+    
+    // SharedWorkers with value <= 0 are not ready
+    std::vector<WorkerPtr> workers;
+    std::size_t expectedRan = 0;
+    for (int i = -50; i < 450; ++i) {
+        workers.push_back(i % 2 ? createHostSharedWorker(i) : createDLLSharedWorker(i));
+        expectedRan += i > 0 ? 1 : 0;
+    }
+    for (int i = 0; i < 100; ++i) {
+        workers.push_back(i % 2 ? createHostTemplatedWorkerInt(i) : createDLLTemplatedWorkerInt(i));
+        ++expectedRan;
+    }
+    workers.push_back(nullptr);
+    
+    WorkerExecutor executor(4);
+    EXPECT_EQ(executor.threadCount(), 4u);
+    
+    std::vector<std::atomic<int>> visits(workers.size());
+    std::atomic<std::size_t> ranCallbacks(0);
+    const std::size_t ran = executor.run(workers, [&](AbstractWorker& worker, bool didRun) {
+        for (std::size_t i = 0; i < workers.size(); ++i) {
+            if (workers[i].get() == &worker) ++visits[i];
+        }
+        EXPECT_EQ(didRun, worker.isReady());
+        if (didRun) ++ranCallbacks;
+    });
+    
+    EXPECT_EQ(ran, expectedRan);
+    EXPECT_EQ(ranCallbacks.load(), expectedRan);
+    for (std::size_t i = 0; i + 1 < workers.size(); ++i) {
+        EXPECT_EQ(visits[i].load(), 1) << "worker " << i;
+    }
+    EXPECT_EQ(visits.back().load(), 0);
+    
+    // The executor is reusable and handles empty batches
+    EXPECT_EQ(executor.run(workers), expectedRan);
+    EXPECT_EQ(executor.run(std::vector<WorkerPtr>()), 0u);
+}
+
+// Test that worker exceptions surface after the batch completes
+TEST(WeakSymbolLinking, WorkerExecutorPropagatesExceptions) {
+    OutputRestorer restorer;
+    setWorkerOutputMode(WorkerOutputMode::Discard);
+    
+    std::vector<WorkerPtr> workers;
+    for (int i = 1; i <= 64; ++i) {
+        workers.push_back(createDLLSharedWorker(i));
+    }
+    workers.push_back(std::make_unique<ThrowingWorker>());
+    
+    WorkerExecutor executor(2);
+    std::atomic<int> completed(0);
+    EXPECT_THROW(executor.run(workers, [&](AbstractWorker&, bool) { ++completed; }),
+                 std::runtime_error);
+    EXPECT_EQ(completed.load(), 64);
+}
+
+// Test the struct-of-arrays SharedWorker store
+TEST(WeakSymbolLinking, SharedWorkerStoreQueries) {
+    SharedWorkerStore store;
+    store.reserve(8);
+    
+    auto hostWorker = createHostSharedWorker(40);
+    EXPECT_EQ(store.add(*dynamic_cast<SharedWorker*>(hostWorker.get())), 0u);
+    store.add(-5, "DLL");
+    store.add(0, "HOST");
+    store.add(7, "DLL");
+    store.add(12, "DLL-C-Interface");
+    ASSERT_EQ(store.size(), 5u);
+    
+    // Source names are interned, so equal names share one handle
+    EXPECT_EQ(store.sourceName(0), store.sourceName(2));
+    EXPECT_EQ(store.sourceName(1), store.sourceName(3));
+    EXPECT_NE(store.sourceName(0), store.sourceName(1));
+    EXPECT_EQ(store.source(4), "DLL-C-Interface");
+    
+    // Bulk queries agree with SharedWorker::isReady / getValue
+    EXPECT_EQ(store.countReady(), 3u);
+    EXPECT_EQ(store.sumValues(), 40 - 5 + 0 + 7 + 12);
+    EXPECT_EQ(store.filterReady(), (std::vector<std::size_t>{0, 3, 4}));
+    EXPECT_EQ(store.filterBySource(SourceName("DLL")), (std::vector<std::size_t>{1, 3}));
+    EXPECT_EQ(store.filterByValue(0, 10), (std::vector<std::size_t>{2, 3}));
+    
+    store.setValue(2, 3);
+    EXPECT_EQ(store.countReady(), 4u);
+    
+    // Views read and write the columns in place
+    for (std::size_t i = 0; i < store.size(); ++i) {
+        SharedWorkerStore::View view = store.view(i);
+        IBaseObject* base = &view;
+        EXPECT_NE(dynamic_cast<AbstractWorker*>(base), nullptr);
+        EXPECT_EQ(base->getValue(), store.value(i));
+        EXPECT_EQ(view.getSourceName(), store.sourceName(i));
+        EXPECT_EQ(view.isReady(), store.value(i) > 0);
+    }
+    SharedWorkerStore::View view = store.view(1);
+    view.setValue(9);
+    EXPECT_EQ(store.value(1), 9);
+    store.setValue(1, -5);
+    EXPECT_EQ(view.getValue(), -5);
+    EXPECT_EQ(view.getDescription(), "SharedWorker created from DLL with value -5");
+    
+    // Materialized entries are ordinary SharedWorkers
+    for (std::size_t i = 0; i < store.size(); ++i) {
+        auto worker = store.materialize(i);
+        IBaseObject* base = worker.get();
+        EXPECT_NE(dynamic_cast<SharedWorker*>(base), nullptr);
+        EXPECT_EQ(typeId(base), kSharedWorkerTypeId);
+        EXPECT_EQ(worker->getValue(), store.value(i));
+        EXPECT_EQ(worker->getSourceName(), store.sourceName(i));
+        EXPECT_EQ(worker->isReady(), store.value(i) > 0);
+    }
+}
+
+// Test that source names are interned across the boundary
+TEST(WeakSymbolLinking, SourceNameInterning) {
+    auto dllWorker = createDLLSharedWorker(1);
+    auto localDll = std::make_unique<SharedWorker>(2, "DLL");
+    auto dllTemplated = createDLLTemplatedWorkerInt(3);
+    auto hostWorker = createHostSharedWorker(4);
+    
+    SharedWorker* dllShared = dynamic_cast<SharedWorker*>(dllWorker.get());
+    SharedWorker* hostShared = dynamic_cast<SharedWorker*>(hostWorker.get());
+    auto* dllInt = dynamic_cast<TemplatedWorker<int>*>(dllTemplated.get());
+    ASSERT_NE(dllShared, nullptr);
+    ASSERT_NE(hostShared, nullptr);
+    ASSERT_NE(dllInt, nullptr);
+    
+    // Same name, same handle, same storage, regardless of which side created it
+    EXPECT_EQ(dllShared->getSourceName(), localDll->getSourceName());
+    EXPECT_EQ(dllShared->getSourceName(), dllInt->getSourceName());
+    EXPECT_EQ(&dllShared->getSource(), &localDll->getSource());
+    EXPECT_NE(dllShared->getSourceName(), hostShared->getSourceName());
+    EXPECT_EQ(hostShared->getSourceName(), SourceName(std::string("HOST")));
+    EXPECT_EQ(dllInt->getSource(), "DLL");
+    
+    // The handle replaces a std::string member
+    EXPECT_LT(sizeof(SharedWorker), sizeof(AbstractWorker) + sizeof(int) + sizeof(std::string));
+}
+
+#ifndef WEAK_SYMBOL_STATIC_LTO
+// Test runtime-loaded plugins: their workers share RTTI with host and DLL
+TEST(WeakSymbolLinking, PluginLoaderUnifiesRtti) {
+    PluginRegistry registry;
+    std::string error;
+    const PluginDescriptor* plugin = registry.load(WEAK_SYMBOL_SAMPLE_PLUGIN_PATH, &error);
+    ASSERT_NE(plugin, nullptr) << error;
+    EXPECT_STREQ(plugin->name, "SamplePlugin");
+    EXPECT_EQ(registry.load(WEAK_SYMBOL_SAMPLE_PLUGIN_PATH), plugin);
+    EXPECT_EQ(registry.names(), std::vector<std::string>{"SamplePlugin"});
+    
+    // Shared types created inside the plugin cast on the host and in the DLL
+    auto shared = registry.createSharedWorker("SamplePlugin", 7);
+    ASSERT_NE(shared, nullptr);
+    EXPECT_EQ(&typeid(*shared), &typeid(SharedWorker));
+    auto* sharedWorker = dynamic_cast<SharedWorker*>(shared.get());
+    ASSERT_NE(sharedWorker, nullptr);
+    EXPECT_EQ(sharedWorker->getSource(), "SamplePlugin");
+    EXPECT_TRUE(testDynamicCast(shared.get()));
+    EXPECT_EQ(typeId(shared.get()), kSharedWorkerTypeId);
+    
+    auto templated = registry.createTemplatedWorkerString("SamplePlugin", "plugin");
+    ASSERT_NE(cachedCast<TemplatedWorker<std::string>>(templated.get()), nullptr);
+    EXPECT_EQ(cachedCast<TemplatedWorker<std::string>>(templated.get())->getData(), "plugin");
+    
+    // The plugin's own worker type is usable through the shared interfaces
+    auto worker = registry.createWorker("SamplePlugin", 2);
+    ASSERT_NE(worker, nullptr);
+    EXPECT_EQ(worker->getTypeName(), "CountdownWorker");
+    EXPECT_EQ(dynamic_cast<SharedWorker*>(worker.get()), nullptr);
+    EXPECT_GE(typeId(worker.get()), static_cast<TypeId>(kFirstDynamicTypeId));
+    worker->doWork();
+    worker->doWork();
+    EXPECT_FALSE(worker->isReady());
+    
+    EXPECT_EQ(registry.createWorker("MissingPlugin", 1), nullptr);
+}
+
+TEST(WeakSymbolLinking, PluginLoaderRejectsInvalidLibraries) {
+    PluginRegistry registry;
+    std::string error;
+    EXPECT_EQ(registry.load("/nonexistent/libMissingPlugin.so", &error), nullptr);
+    EXPECT_FALSE(error.empty());
+    
+    // A library without the entry point is not a plugin
+    error.clear();
+    EXPECT_EQ(registry.load(WEAK_SYMBOL_LIBRARY_PATH, &error), nullptr);
+    EXPECT_NE(error.find("weak_symbol_plugin_descriptor"), std::string::npos);
+    EXPECT_EQ(registry.size(), 0u);
+}
+
+namespace {
+
+    // Whether the dynamic loader still has a library open under this path
+    bool isLibraryLoaded(const std::string& path) {
+        void* handle = dlopen(path.c_str(), RTLD_LAZY | RTLD_NOLOAD);
+        if (handle) dlclose(handle);
+        return handle != nullptr;
+    }
+
+} // namespace
+
+// Test hot reload: old workers keep their generation loaded until they die
+TEST(WeakSymbolLinking, HotReloadRetiresOldGeneration) {
+    LibraryReloader reloader(WEAK_SYMBOL_LIBRARY_PATH);
+    EXPECT_EQ(reloader.createSharedWorker(1), nullptr);
+    
+    std::string error;
+    ASSERT_TRUE(reloader.reload(&error)) << error;
+    auto oldWorker = reloader.createSharedWorker(1);
+    const std::string oldPath = reloader.loadedPath();
+    
+    ASSERT_TRUE(reloader.reload(&error)) << error;
+    auto newWorker = reloader.createTemplatedWorkerInt(2);
+    ASSERT_NE(oldWorker, nullptr);
+    ASSERT_NE(newWorker, nullptr);
+    EXPECT_EQ(reloader.generation(), 2u);
+    EXPECT_EQ(oldWorker.get_deleter().generation(), 1u);
+    EXPECT_EQ(newWorker.get_deleter().generation(), 2u);
+    EXPECT_NE(reloader.loadedPath(), oldPath);
+    EXPECT_EQ(reloader.loadedGenerations(), 2u);
+    
+    // Workers from every generation share RTTI with the host and the DLL
+    auto* shared = dynamic_cast<SharedWorker*>(oldWorker.get());
+    ASSERT_NE(shared, nullptr);
+    EXPECT_EQ(shared->getSource(), "DLL-C-Interface");
+    EXPECT_TRUE(testDynamicCast(newWorker.get()));
+    EXPECT_EQ(cachedCast<TemplatedWorker<int>>(newWorker.get())->getData(), 2);
+    
+    // The old generation goes away with its last worker; GCC builds without
+    // WEAK_SYMBOL_NO_GNU_UNIQUE keep its mapping pinned
+    EXPECT_TRUE(isLibraryLoaded(oldPath));
+    oldWorker.reset();
+    EXPECT_EQ(reloader.loadedGenerations(), 1u);
+#ifdef WEAK_SYMBOL_RELOAD_UNLOADS
+    EXPECT_FALSE(isLibraryLoaded(oldPath));
+#endif
+    EXPECT_TRUE(isLibraryLoaded(reloader.loadedPath()));
+}
+
+// Test hot reload of a different build: new workers come from its factories
+TEST(WeakSymbolLinking, HotReloadUsesNewBuildFactories) {
+    char path[] = "/tmp/WeakSymbolLib-reload-XXXXXX";
+    const int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    close(fd);
+    auto install = [&path](const char* build) {
+        std::ifstream in(build, std::ios::binary);
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        return in && out && (out << in.rdbuf());
+    };
+    
+    LibraryReloader reloader(path);
+    std::string error;
+    ASSERT_TRUE(install(WEAK_SYMBOL_LIBRARY_PATH));
+    ASSERT_TRUE(reloader.reload(&error)) << error;
+    auto oldWorker = reloader.createSharedWorker(1);
+    
+    // Replace the file at the reloader's path, as a rebuild would
+    ASSERT_TRUE(install(WEAK_SYMBOL_NEXT_LIBRARY_PATH));
+    ASSERT_TRUE(reloader.reload(&error)) << error;
+    auto newWorker = reloader.createSharedWorker(2);
+    auto newTemplated = reloader.createTemplatedWorkerString("next");
+    unlink(path);
+    
+    auto* oldShared = dynamic_cast<SharedWorker*>(oldWorker.get());
+    auto* newShared = dynamic_cast<SharedWorker*>(newWorker.get());
+    auto* templated = dynamic_cast<TemplatedWorker<std::string>*>(newTemplated.get());
+    ASSERT_NE(oldShared, nullptr);
+    ASSERT_NE(newShared, nullptr);
+    ASSERT_NE(templated, nullptr);
+    EXPECT_EQ(oldShared->getSource(), "DLL-C-Interface");
+    EXPECT_EQ(newShared->getSource(), "DLL-C-Interface-Next");
+    EXPECT_EQ(templated->getSource(), "DLL-C-Interface-Next");
+    EXPECT_EQ(templated->getData(), "next");
+    EXPECT_EQ(newWorker.get_deleter().generation(), 2u);
+}
+
+// Test that a build with another shared type layout is not loaded
+TEST(WeakSymbolLinking, HotReloadRejectsLayoutMismatch) {
+    LibraryReloader reloader(WEAK_SYMBOL_LIBRARY_PATH, libraryLayoutStamp() + 1);
+    std::string error;
+    EXPECT_FALSE(reloader.reload(&error));
+    EXPECT_NE(error.find("layout"), std::string::npos);
+    EXPECT_EQ(reloader.generation(), 0u);
+    EXPECT_EQ(reloader.createSharedWorker(1), nullptr);
+    EXPECT_EQ(reloader.loadedGenerations(), 0u);
+    
+    LibraryReloader matching(WEAK_SYMBOL_NEXT_LIBRARY_PATH);
+    EXPECT_TRUE(matching.reload(&error)) << error;
+}
+
+#endif // WEAK_SYMBOL_STATIC_LTO
+
 // Test weak symbol function unification
 TEST(WeakSymbolLinking, WeakSymbolFunctions) {
     // Test that DLL weak symbol functions work
@@ -208,6 +1411,22 @@ TEST(WeakSymbolLinking, WeakSymbolFunctions) {
 
 // Main function - Google Test entry point
 int main(int argc, char** argv) {
+    // Instrumentation modes handled before Google Test sees the arguments
+    bool latencyReport = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--latency-report") {
+            latencyReport = true;
+        }
+        if (arg == "--profile-startup") {
+            return runStartupProfile();
+        }
+        if (arg == "--startup-probe") {
+            // Child process used by the profiler to capture loader statistics
+            return 0;
+        }
+    }
+    
     std::cout << "Weak Symbol Linking Demonstration with Google Test" << std::endl;
     std::cout << "Platform: macOS" << std::endl;
     std::cout << "Compiler: " << __VERSION__ << std::endl;
@@ -218,5 +1437,11 @@ int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     
     // Run all tests
-    return RUN_ALL_TESTS();
+    const int result = RUN_ALL_TESTS();
+    
+    // Latencies of every library entry point the tests called
+    if (latencyReport) {
+        std::cout << std::endl << formatLatencyReport();
+    }
+    return result;
 } 
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "plugin_loader.h"
+#include "../include/shared_class.h"
+#include <dlfcn.h>
+#include <typeinfo>
+
+namespace WeakSymbolExample {
+
+    namespace {
+
+        void setError(std::string* error, const std::string& message) {
+            if (error) *error = message;
+        }
+
+        // Compare type_info objects by address: operator== may fall back to
+        // comparing names, which would hide a duplicated type_info
+        bool sameTypeInfo(const std::type_info& plugin, const std::type_info& host) {
+            return &plugin == &host;
+        }
+
+        // Create an object inside the plugin and cast it on the host side
+        template<typename T>
+        bool castsOnHost(const PluginDescriptor& descriptor, AbstractWorker* obj) {
+            const bool unified = dynamic_cast<T*>(static_cast<IBaseObject*>(obj)) != nullptr;
+            descriptor.destroyObject(obj);
+            return unified;
+        }
+
+        // Reasons a plugin's RTTI does not unify, or an empty string
+        std::string checkUnification(const PluginDescriptor& descriptor) {
+            if (!sameTypeInfo(descriptor.sharedWorkerType(), typeid(SharedWorker)) ||
+                !sameTypeInfo(descriptor.templatedWorkerIntType(), typeid(TemplatedWorker<int>)) ||
+                !sameTypeInfo(descriptor.templatedWorkerStringType(), typeid(TemplatedWorker<std::string>))) {
+                return "type_info of the shared worker types is not unified with the host";
+            }
+            if (!castsOnHost<SharedWorker>(descriptor, descriptor.createSharedWorker(1)) ||
+                !castsOnHost<TemplatedWorker<int>>(descriptor, descriptor.createTemplatedWorkerInt(1)) ||
+                !castsOnHost<TemplatedWorker<std::string>>(descriptor, descriptor.createTemplatedWorkerString(""))) {
+                return "dynamic_cast on plugin-created workers fails in the host";
+            }
+            return std::string();
+        }
+
+        bool isComplete(const PluginDescriptor& descriptor) {
+            return descriptor.name && descriptor.createWorker && descriptor.createSharedWorker &&
+                   descriptor.createTemplatedWorkerInt && descriptor.createTemplatedWorkerString &&
+                   descriptor.destroyObject && descriptor.sharedWorkerType &&
+                   descriptor.templatedWorkerIntType && descriptor.templatedWorkerStringType;
+        }
+
+    } // namespace
+
+    const PluginDescriptor* PluginRegistry::load(const std::string& path, std::string* error) {
+        void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_GLOBAL);
+        if (!handle) {
+            const char* reason = dlerror();
+            setError(error, reason ? reason : "dlopen failed for " + path);
+            return nullptr;
+        }
+        
+        // dlopen hands back the same handle for a library that is already open
+        for (const Entry& entry : m_plugins) {
+            if (entry.handle == handle) {
+                dlclose(handle);
+                return entry.descriptor;
+            }
+        }
+        
+        const auto reject = [&](const std::string& reason) -> const PluginDescriptor* {
+            dlclose(handle);
+            setError(error, path + ": " + reason);
+            return nullptr;
+        };
+        
+        void* symbol = dlsym(handle, kPluginEntryPoint);
+        if (!symbol) {
+            return reject(std::string("missing entry point ") + kPluginEntryPoint);
+        }
+        
+        const PluginDescriptor* descriptor = reinterpret_cast<PluginEntryPoint>(symbol)();
+        if (!descriptor || descriptor->abiVersion != kPluginAbiVersion) {
+            return reject("unsupported plugin ABI version");
+        }
+        if (!isComplete(*descriptor)) {
+            return reject("incomplete plugin descriptor");
+        }
+        if (find(descriptor->name)) {
+            return reject(std::string("a plugin named ") + descriptor->name + " is already loaded");
+        }
+        
+        const std::string mismatch = checkUnification(*descriptor);
+        if (!mismatch.empty()) {
+            return reject(mismatch);
+        }
+        
+        m_plugins.push_back(Entry{path, handle, descriptor});
+        return descriptor;
+    }
+
+    const PluginDescriptor* PluginRegistry::find(const std::string& name) const {
+        for (const Entry& entry : m_plugins) {
+            if (name == entry.descriptor->name) return entry.descriptor;
+        }
+        return nullptr;
+    }
+
+    std::vector<std::string> PluginRegistry::names() const {
+        std::vector<std::string> result;
+        result.reserve(m_plugins.size());
+        for (const Entry& entry : m_plugins) {
+            result.push_back(entry.descriptor->name);
+        }
+        return result;
+    }
+
+    // Plugin objects carry the usual allocation header and their code stays
+    // mapped, so the default deleter releases them correctly
+
+    WorkerPtr PluginRegistry::createWorker(const std::string& plugin, int value) const {
+        const PluginDescriptor* descriptor = find(plugin);
+        return WorkerPtr(descriptor ? descriptor->createWorker(value) : nullptr);
+    }
+
+    WorkerPtr PluginRegistry::createSharedWorker(const std::string& plugin, int value) const {
+        const PluginDescriptor* descriptor = find(plugin);
+        return WorkerPtr(descriptor ? descriptor->createSharedWorker(value) : nullptr);
+    }
+
+    WorkerPtr PluginRegistry::createTemplatedWorkerInt(const std::string& plugin, int value) const {
+        const PluginDescriptor* descriptor = find(plugin);
+        return WorkerPtr(descriptor ? descriptor->createTemplatedWorkerInt(value) : nullptr);
+    }
+
+    WorkerPtr PluginRegistry::createTemplatedWorkerString(const std::string& plugin,
+                                                          const std::string& value) const {
+        const PluginDescriptor* descriptor = find(plugin);
+        return WorkerPtr(descriptor ? descriptor->createTemplatedWorkerString(value.c_str()) : nullptr);
+    }
+
+} // namespace WeakSymbolExample
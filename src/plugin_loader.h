@@ -0,0 +1,53 @@
+#pragma once
+
+#include "../include/base_types.h"
+#include "../lib/plugin_api.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Runtime loading of worker plugins (see lib/plugin_api.h)
+namespace WeakSymbolExample {
+
+    // Registry of plugins loaded with dlopen, keyed by descriptor name
+    // Plugins are opened RTLD_NOW | RTLD_GLOBAL so their vague-linkage symbols
+    // (type_info, vtables, inline functions) bind to the copies already in the
+    // process, and a plugin is only accepted once that has been verified.
+    // Libraries stay loaded for the life of the process, so objects created
+    // from a plugin may outlive the registry and are deleted like any other
+    class PluginRegistry {
+    public:
+        PluginRegistry() {}
+        PluginRegistry(const PluginRegistry&) = delete;
+        PluginRegistry& operator=(const PluginRegistry&) = delete;
+        
+        // Load a plugin and verify that its RTTI unifies with the host's
+        // Returns nullptr and fills error on failure; loading a library that
+        // is already registered returns its existing descriptor
+        const PluginDescriptor* load(const std::string& path, std::string* error = nullptr);
+        
+        // Descriptor of a loaded plugin, or nullptr
+        const PluginDescriptor* find(const std::string& name) const;
+        
+        std::vector<std::string> names() const;
+        std::size_t size() const {
+            return m_plugins.size();
+        }
+        
+        // Factories of a loaded plugin; return nullptr if it is not loaded
+        WorkerPtr createWorker(const std::string& plugin, int value) const;
+        WorkerPtr createSharedWorker(const std::string& plugin, int value) const;
+        WorkerPtr createTemplatedWorkerInt(const std::string& plugin, int value) const;
+        WorkerPtr createTemplatedWorkerString(const std::string& plugin, const std::string& value) const;
+        
+    private:
+        struct Entry {
+            std::string path;
+            void* handle;
+            const PluginDescriptor* descriptor;
+        };
+        
+        std::vector<Entry> m_plugins;
+    };
+
+} // namespace WeakSymbolExample
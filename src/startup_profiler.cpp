@@ -0,0 +1,307 @@
+#include "startup_profiler.h"
+#include "../include/base_types.h"
+#include "../include/shared_class.h"
+#include "../lib/shared_library.h"
+#include <chrono>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <cstdlib>
+#include <link.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace WeakSymbolExample {
+
+    namespace {
+
+        using Clock = std::chrono::steady_clock;
+
+        double microsecondsSince(Clock::time_point start) {
+            return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        }
+
+        std::string demangle(const char* mangled) {
+            int status = 0;
+            std::unique_ptr<char, void (*)(void*)> demangled(
+                abi::__cxa_demangle(mangled, nullptr, nullptr, &status), std::free);
+            return status == 0 && demangled ? demangled.get() : mangled;
+        }
+
+        std::string baseName(const std::string& path) {
+            const std::string::size_type slash = path.find_last_of('/');
+            return slash == std::string::npos ? path : path.substr(slash + 1);
+        }
+
+        // A symbol of interest, located through an address in this process
+        struct SymbolProbe {
+            const char* label;
+            const void* address;
+            std::string mangledName;
+            std::string definingObject;
+        };
+
+        // Interposed weak functions plus vague-linkage type_info and vtables
+        std::vector<SymbolProbe> collectProbes() {
+            static SharedWorker sharedWorker(1, "PROFILE");
+            static TemplatedWorker<int> intWorker(1, "PROFILE");
+            static TemplatedWorker<std::string> stringWorker(std::string("x"), "PROFILE");
+
+            // The vtable symbol is the nearest one below an object's vptr
+            auto vtableOf = [](const IBaseObject& obj) {
+                return *reinterpret_cast<const void* const*>(&obj);
+            };
+
+            using SharedWorkerFactory = std::unique_ptr<AbstractWorker> (*)(int, AllocationPolicy);
+            const SharedWorkerFactory sharedWorkerFactory = &createDLLSharedWorker;
+            std::vector<SymbolProbe> probes = {
+                {"Internal::getSharedFunctionResult", reinterpret_cast<const void*>(&Internal::getSharedFunctionResult), "", ""},
+                {"Internal::performSharedOperation", reinterpret_cast<const void*>(&Internal::performSharedOperation), "", ""},
+                {"createDLLSharedWorker", reinterpret_cast<const void*>(sharedWorkerFactory), "", ""},
+                {"create_dll_object_c", reinterpret_cast<const void*>(&create_dll_object_c), "", ""},
+                {"typeinfo SharedWorker", &typeid(SharedWorker), "", ""},
+                {"typeinfo TemplatedWorker<int>", &typeid(TemplatedWorker<int>), "", ""},
+                {"typeinfo TemplatedWorker<string>", &typeid(TemplatedWorker<std::string>), "", ""},
+                {"vtable SharedWorker", vtableOf(sharedWorker), "", ""},
+                {"vtable TemplatedWorker<int>", vtableOf(intWorker), "", ""},
+                {"vtable TemplatedWorker<string>", vtableOf(stringWorker), "", ""},
+            };
+
+            for (SymbolProbe& probe : probes) {
+                Dl_info info;
+                if (dladdr(probe.address, &info) && info.dli_sname) {
+                    probe.mangledName = info.dli_sname;
+                    probe.definingObject = info.dli_fname ? baseName(info.dli_fname) : "?";
+                }
+            }
+            return probes;
+        }
+
+        std::string libraryPath() {
+            Dl_info info;
+            if (dladdr(reinterpret_cast<const void*>(&create_dll_object_c), &info) && info.dli_fname) {
+                return info.dli_fname;
+            }
+            return "";
+        }
+
+        void reportSymbolResolution(const std::vector<SymbolProbe>& probes) {
+            std::cout << "\n== Symbol resolution in this process ==" << std::endl;
+            for (const SymbolProbe& probe : probes) {
+                std::cout << "  " << std::left << std::setw(36) << probe.label
+                          << (probe.mangledName.empty() ? "(no dynamic symbol)" : probe.definingObject)
+                          << std::endl;
+            }
+        }
+
+#if defined(__linux__)
+
+        // Per-object segment and relocation counts from the dynamic section
+        int reportObject(struct dl_phdr_info* info, size_t, void*) {
+            std::size_t loads = 0;
+            std::size_t mapped = 0;
+            std::size_t relocations = 0;
+            std::size_t pltRelocations = 0;
+            std::size_t relocationEntry = sizeof(ElfW(Rela));
+            std::size_t relocationBytes = 0;
+            bool bindNow = false;
+
+            for (ElfW(Half) i = 0; i < info->dlpi_phnum; ++i) {
+                const ElfW(Phdr)& header = info->dlpi_phdr[i];
+                if (header.p_type == PT_LOAD) {
+                    ++loads;
+                    mapped += header.p_memsz;
+                }
+                if (header.p_type != PT_DYNAMIC) continue;
+
+                const auto* dynamic = reinterpret_cast<const ElfW(Dyn)*>(info->dlpi_addr + header.p_vaddr);
+                for (; dynamic->d_tag != DT_NULL; ++dynamic) {
+                    switch (dynamic->d_tag) {
+                        case DT_RELASZ: relocationBytes = dynamic->d_un.d_val; break;
+                        case DT_RELAENT: relocationEntry = dynamic->d_un.d_val; break;
+                        case DT_PLTRELSZ: pltRelocations = dynamic->d_un.d_val / sizeof(ElfW(Rela)); break;
+                        case DT_BIND_NOW: bindNow = true; break;
+                        case DT_FLAGS: bindNow |= (dynamic->d_un.d_val & DF_BIND_NOW) != 0; break;
+                        case DT_FLAGS_1: bindNow |= (dynamic->d_un.d_val & DF_1_NOW) != 0; break;
+                        default: break;
+                    }
+                }
+            }
+            relocations = relocationEntry ? relocationBytes / relocationEntry : 0;
+
+            const std::string name = info->dlpi_name && *info->dlpi_name ? baseName(info->dlpi_name) : "(main program)";
+            std::cout << "  " << std::left << std::setw(28) << name
+                      << " segments: " << loads
+                      << "  mapped: " << std::setw(8) << mapped
+                      << " relocs: " << std::setw(6) << relocations
+                      << " plt relocs: " << std::setw(5) << pltRelocations
+                      << (bindNow ? " (bind now)" : " (lazy)") << std::endl;
+            return 0;
+        }
+
+        // Re-run this executable with the loader's debug output enabled
+        std::string runWithLoaderDebug(const char* debugFlags) {
+            int pipeFds[2];
+            if (pipe(pipeFds) != 0) return "";
+
+            const pid_t child = fork();
+            if (child == 0) {
+                dup2(pipeFds[1], STDERR_FILENO);
+                close(pipeFds[0]);
+                close(pipeFds[1]);
+                setenv("LD_DEBUG", debugFlags, 1);
+                execl("/proc/self/exe", "WeakSymbolHost", "--startup-probe", static_cast<char*>(nullptr));
+                _exit(127);
+            }
+
+            close(pipeFds[1]);
+            std::string output;
+            char buffer[4096];
+            ssize_t count;
+            while ((count = read(pipeFds[0], buffer, sizeof(buffer))) > 0) {
+                output.append(buffer, static_cast<std::size_t>(count));
+            }
+            close(pipeFds[0]);
+            if (child > 0) waitpid(child, nullptr, 0);
+            return output;
+        }
+
+        // Strip the "     PID:\t" prefix from a loader debug line
+        std::string stripPid(const std::string& line) {
+            const std::string::size_type colon = line.find(':');
+            if (colon == std::string::npos) return line;
+            const std::string::size_type text = line.find_first_not_of(" \t", colon + 1);
+            return text == std::string::npos ? "" : line.substr(text);
+        }
+
+        void reportLoaderStatistics() {
+            std::cout << "\n== Dynamic loader phases (LD_DEBUG=statistics) ==" << std::endl;
+            const std::string output = runWithLoaderDebug("statistics");
+            std::string::size_type start = 0;
+            bool any = false;
+            while (start < output.size()) {
+                std::string::size_type end = output.find('\n', start);
+                if (end == std::string::npos) end = output.size();
+                const std::string line = stripPid(output.substr(start, end - start));
+                if (!line.empty()) {
+                    std::cout << "  " << line << std::endl;
+                    any = true;
+                }
+                start = end + 1;
+            }
+            if (!any) std::cout << "  (no statistics reported by the loader)" << std::endl;
+        }
+
+        void reportSymbolBindings() {
+            std::cout << "\n== Startup bindings of WeakSymbolExample symbols (LD_DEBUG=bindings) ==" << std::endl;
+            const std::string output = runWithLoaderDebug("bindings");
+
+            // "binding file A [0] to B [0]: normal symbol `name' [VERSION]"
+            std::map<std::string, std::map<std::string, int>> bindings;
+            std::size_t total = 0;
+            std::string::size_type start = 0;
+            while (start < output.size()) {
+                std::string::size_type end = output.find('\n', start);
+                if (end == std::string::npos) end = output.size();
+                const std::string line = stripPid(output.substr(start, end - start));
+                start = end + 1;
+
+                if (line.compare(0, 13, "binding file ") != 0) continue;
+                ++total;
+                const std::string::size_type to = line.find(" to ");
+                const std::string::size_type colon = line.find(": ", to);
+                const std::string::size_type open = line.find('`', colon);
+                const std::string::size_type close = line.find('\'', open);
+                if (to == std::string::npos || colon == std::string::npos ||
+                    open == std::string::npos || close == std::string::npos) continue;
+
+                const std::string symbol = line.substr(open + 1, close - open - 1);
+                if (symbol.find("17WeakSymbolExample") == std::string::npos &&
+                    symbol.find("_dll_") == std::string::npos) continue;
+
+                const std::string from = baseName(line.substr(13, line.find(" [", 13) - 13));
+                const std::string target = baseName(line.substr(to + 4, line.find(" [", to + 4) - to - 4));
+                ++bindings[demangle(symbol.c_str())][from + " -> " + target];
+            }
+
+            for (const auto& symbol : bindings) {
+                std::cout << "  " << symbol.first << std::endl;
+                for (const auto& edge : symbol.second) {
+                    std::cout << "      " << edge.first << " (" << edge.second << "x)" << std::endl;
+                }
+            }
+            std::cout << "  total symbol bindings at startup: " << total << std::endl;
+        }
+
+        // Load a fresh copy of the library in a new link-map namespace
+        void reportFreshLoad(const std::string& path, const std::vector<SymbolProbe>& probes) {
+            std::cout << "\n== Fresh load of " << baseName(path) << " (dlmopen, new namespace) ==" << std::endl;
+            for (int mode : {RTLD_LAZY, RTLD_NOW}) {
+                const Clock::time_point start = Clock::now();
+                void* handle = dlmopen(LM_ID_NEWLM, path.c_str(), mode | RTLD_LOCAL);
+                const double loadMicros = microsecondsSince(start);
+                if (!handle) {
+                    std::cout << "  dlmopen failed: " << dlerror() << std::endl;
+                    return;
+                }
+                std::cout << "  " << (mode == RTLD_NOW ? "RTLD_NOW " : "RTLD_LAZY")
+                          << " load + relocate: " << std::fixed << std::setprecision(1)
+                          << loadMicros << " us" << std::endl;
+
+                if (mode == RTLD_NOW) {
+                    std::cout << "  per-symbol lookup (dlsym):" << std::endl;
+                    for (const SymbolProbe& probe : probes) {
+                        if (probe.mangledName.empty()) continue;
+                        const Clock::time_point lookupStart = Clock::now();
+                        void* address = dlsym(handle, probe.mangledName.c_str());
+                        const double lookupMicros = microsecondsSince(lookupStart);
+                        std::cout << "    " << std::left << std::setw(36) << probe.label
+                                  << std::right << std::setw(8) << lookupMicros << " us"
+                                  << (address ? "" : "  (not exported)") << std::endl;
+                    }
+                }
+                dlclose(handle);
+            }
+        }
+
+#endif // __linux__
+
+    } // namespace
+
+    int runStartupProfile() {
+        std::cout << "Startup profile for WeakSymbolHost" << std::endl;
+        const std::vector<SymbolProbe> probes = collectProbes();
+
+#if defined(__linux__)
+        std::cout << "\n== Loaded objects ==" << std::endl;
+        dl_iterate_phdr(&reportObject, nullptr);
+
+        reportLoaderStatistics();
+        reportSymbolBindings();
+        reportSymbolResolution(probes);
+
+#if defined(WEAK_SYMBOL_STATIC_LTO)
+        std::cout << "\nlibWeakSymbolLib is linked statically (WEAK_SYMBOL_STATIC_LTO); "
+                  << "there is no library to load" << std::endl;
+#else
+        const std::string path = libraryPath();
+        if (!path.empty()) {
+            reportFreshLoad(path, probes);
+        }
+#endif
+#else
+        reportSymbolResolution(probes);
+        std::cout << "\nLoader phase statistics are only available on Linux" << std::endl;
+#endif
+        return 0;
+    }
+
+} // namespace WeakSymbolExample
@@ -0,0 +1,11 @@
+#pragma once
+
+// Startup instrumentation for WeakSymbolHost (--profile-startup)
+// Reports how long libWeakSymbolLib takes to load, relocate and bind,
+// broken down per loader phase and per interposed / vague-linkage symbol
+namespace WeakSymbolExample {
+
+    // Run the full report on stdout; returns a process exit code
+    int runStartupProfile();
+
+} // namespace WeakSymbolExample
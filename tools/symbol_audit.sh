@@ -0,0 +1,160 @@
+#!/bin/bash
+
+set -e  # Exit on error
+
+# Symbol visibility audit for WeakSymbolHost and libWeakSymbolLib
+#
+# Reports the size of each export table, every weak and vague-linkage symbol
+# (vtables, type_info, guard variables, inline and template functions), the
+# symbols defined in both binaries, and whether each type_info / vtable
+# defined on both sides can unify at runtime (exported by both binaries).
+# Exits with status 1 if any type_info or vtable pair cannot unify.
+#
+# Usage: tools/symbol_audit.sh <WeakSymbolHost> <libWeakSymbolLib> [--all]
+#   --all  include symbols outside namespace WeakSymbolExample
+
+if [ $# -lt 2 ]; then
+    echo "Usage: $0 <WeakSymbolHost> <libWeakSymbolLib> [--all]" >&2
+    exit 2
+fi
+
+HOST="$1"
+LIB="$2"
+# Mangled names of entities declared in namespace WeakSymbolExample
+SCOPE='^_Z[A-Z]*17WeakSymbolExample'
+if [ "$3" = "--all" ]; then
+    SCOPE=""
+fi
+
+WORK="$(mktemp -d)"
+trap 'rm -rf "${WORK}"' EXIT
+
+PLATFORM="$(uname -s)"
+
+# Per binary: <prefix>.all ("<nm type> <mangled name>" for defined symbols),
+# <prefix>.dyn (exported names) and <prefix>.weak (weak definitions)
+collect() {
+    local binary="$1" prefix="$2"
+    if [ "${PLATFORM}" = "Darwin" ]; then
+        nm -U "${binary}" | awk 'NF >= 3 { sub(/^_/, "", $3); print $2, $3 }' > "${prefix}.all"
+        nm -gU "${binary}" | awk 'NF >= 3 { sub(/^_/, "", $3); print $3 }' | sort -u > "${prefix}.dyn"
+        nm -m "${binary}" | awk '/weak external/ { sub(/^_/, "", $NF); print $NF }' | sort -u > "${prefix}.weak"
+    else
+        nm --defined-only "${binary}" 2>/dev/null | awk 'NF >= 3 { sub(/@.*/, "", $3); print $2, $3 }' > "${prefix}.all"
+        nm -D --defined-only "${binary}" | awk 'NF >= 3 { sub(/@.*/, "", $3); print $3 }' | sort -u > "${prefix}.dyn"
+        if [ ! -s "${prefix}.all" ]; then
+            # Stripped binary: only the dynamic symbol table is left
+            nm -D --defined-only "${binary}" | awk 'NF >= 3 { sub(/@.*/, "", $3); print $2, $3 }' > "${prefix}.all"
+        fi
+        awk '$1 ~ /^[WwVvu]$/ { print $2 }' "${prefix}.all" | sort -u > "${prefix}.weak"
+    fi
+    # Global definitions only; locals with equal names never interact
+    awk '$1 ~ /^[A-Zu]$/ { print $2 }' "${prefix}.all" | sort -u > "${prefix}.global"
+}
+
+# Vague-linkage kind of a mangled name, or the given fallback
+CATEGORIZE='
+    function kind(name, fallback) {
+        if (name ~ /^_ZTV/) return "vtable"
+        if (name ~ /^_ZTI/) return "typeinfo"
+        if (name ~ /^_ZTS/) return "typeinfo-name"
+        if (name ~ /^_ZTT/) return "vtt"
+        if (name ~ /^_ZGV/) return "guard"
+        if (name ~ /^_ZT[hvc]/) return "thunk"
+        return fallback
+    }
+'
+
+# Keep lines whose last field (a mangled name) is in scope
+in_scope() {
+    awk -v scope="${SCOPE}" '$NF ~ scope'
+}
+
+# Print "<kind> <mangled> [note]" lines as aligned, demangled rows
+print_rows() {
+    local rows="$1"
+    if [ ! -s "${rows}" ]; then
+        echo "    (none)"
+        return
+    fi
+    cut -d' ' -f2 "${rows}" | c++filt > "${rows}.demangled"
+    paste -d'\t' <(cut -d' ' -f1 "${rows}") "${rows}.demangled" <(cut -s -d' ' -f3- "${rows}") \
+        | awk -F'\t' '{ printf "    %-14s%s%s\n", $1, $2, ($3 == "" ? "" : "  " $3) }'
+}
+
+dynamic_table_bytes() {
+    if [ "${PLATFORM}" != "Darwin" ] && command -v readelf > /dev/null; then
+        local total=0 size
+        for size in $(readelf -SW "$1" | awk '{ for (i = 1; i < NF; i++) if ($i == ".dynsym" || $i == ".dynstr") print $(i + 4) }'); do
+            total=$((total + 16#${size}))
+        done
+        printf ", %d bytes of .dynsym/.dynstr" "${total}"
+    fi
+}
+
+collect "${HOST}" "${WORK}/host"
+collect "${LIB}" "${WORK}/lib"
+
+echo "=== Symbol Visibility Audit ==="
+echo "Host:    ${HOST}"
+echo "Library: ${LIB}"
+
+echo ""
+echo "== Export tables =="
+for side in host lib; do
+    binary="${HOST}"
+    [ "${side}" = "lib" ] && binary="${LIB}"
+    total=$(wc -l < "${WORK}/${side}.dyn")
+    project=$(grep -cE '^_Z[A-Z]*17WeakSymbolExample' "${WORK}/${side}.dyn" || true)
+    printf "  %-24s %6d exported symbols (%d in WeakSymbolExample)%s\n" \
+        "$(basename "${binary}")" "${total}" "${project}" "$(dynamic_table_bytes "${binary}")"
+done
+
+echo ""
+echo "== Weak and vague-linkage symbols${SCOPE:+ (WeakSymbolExample)} =="
+for side in host lib; do
+    binary="${HOST}"
+    [ "${side}" = "lib" ] && binary="${LIB}"
+    echo "  $(basename "${binary}"):"
+    # Weak definitions plus vtables/type_info emitted with strong linkage
+    awk "${CATEGORIZE}"'
+        FNR == NR { weak[$1] = 1; next }
+        ($1 ~ /^[A-Zu]$/ && (($2 in weak) || kind($2, "") != "")) {
+            print kind($2, "inline"), $2
+        }' "${WORK}/${side}.weak" "${WORK}/${side}.all" \
+        | in_scope | sort -k1,1 -k2,2 -u > "${WORK}/${side}.vague"
+    print_rows "${WORK}/${side}.vague"
+    awk '{ count[$1]++ } END { for (k in count) printf "%s %d\n", k, count[k] }' "${WORK}/${side}.vague" \
+        | sort | awk '{ line = line sep $1 ": " $2; sep = ", " } END { if (line) print "    -- " line }'
+done
+
+echo ""
+echo "== Symbols defined in both binaries${SCOPE:+ (WeakSymbolExample)} =="
+# Each row: kind, mangled name, status
+comm -12 "${WORK}/host.global" "${WORK}/lib.global" | in_scope \
+    | awk "${CATEGORIZE}"'
+        FILENAME == ARGV[1] { hostDyn[$1] = 1; next }
+        FILENAME == ARGV[2] { libDyn[$1] = 1; next }
+        {
+            if (($1 in hostDyn) && ($1 in libDyn)) status = "unified"
+            else if ($1 in hostDyn) status = "NOT-UNIFIED(library-copy-not-exported)"
+            else if ($1 in libDyn) status = "NOT-UNIFIED(host-copy-not-exported)"
+            else status = "NOT-UNIFIED(neither-copy-exported)"
+            print kind($1, "function"), $1, status
+        }' "${WORK}/host.dyn" "${WORK}/lib.dyn" - > "${WORK}/duplicates"
+
+awk '{ print $1, $2, "[" $3 "]" }' "${WORK}/duplicates" > "${WORK}/duplicates.rows"
+print_rows "${WORK}/duplicates.rows"
+echo "    -- $(wc -l < "${WORK}/duplicates") duplicated, $(grep -c ' unified$' "${WORK}/duplicates" || true) unified at runtime"
+
+echo ""
+echo "== type_info / vtable unification =="
+awk '($1 == "typeinfo" || $1 == "vtable") && $3 != "unified" { print $1, $2, "[" $3 "]" }' \
+    "${WORK}/duplicates" > "${WORK}/problems"
+pairs=$(awk '$1 == "typeinfo" || $1 == "vtable"' "${WORK}/duplicates" | wc -l)
+if [ -s "${WORK}/problems" ]; then
+    print_rows "${WORK}/problems"
+    echo "❌ $(wc -l < "${WORK}/problems") of ${pairs} type_info/vtable definitions cannot unify"
+    exit 1
+fi
+echo "✅ All ${pairs} type_info/vtable definitions present in both binaries are exported by both"